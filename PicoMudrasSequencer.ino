@@ -3,6 +3,8 @@
 #include "src/dsp/dsp.h"
 #include "src/voice/Voice.h"
 #include "src/utils/Debug.h"
+#include "src/utils/AudioProfiler.h"
+#include "src/utils/SpscQueue.h"
 #include "src/scales/scales.h"
 
 
@@ -14,6 +16,7 @@ Sequencer seq1(1); // Channel 1 for first sequencer
 Sequencer seq2(2); // Channel 2 for second sequencer
 Sequencer seq3(3); // Channel 3 for third sequencer
 Sequencer seq4(4); // Channel 4 for fourth sequencer
+SampleClock sampleClock; // Only runs with SEQUENCER_SAMPLE_CLOCK; kept in step with uClock's settings
 LEDMatrix ledMatrix;
 
 // --- MIDI & Clock ---
@@ -22,6 +25,43 @@ midi::SerialMIDI<Adafruit_USBD_MIDI> serial_usb_midi(raw_usb_midi);
 midi::MidiInterface<midi::SerialMIDI<Adafruit_USBD_MIDI>> usb_midi(serial_usb_midi);
 Adafruit_MPR121 touchSensor = Adafruit_MPR121();
 
+// --- Build options ---
+// Render voices a block at a time (VoiceManager::processAllVoicesBlock); set to 0
+// to fall back to the per-sample processAllVoices() path for comparison.
+#ifndef VOICE_BLOCK_PROCESSING
+#define VOICE_BLOCK_PROCESSING 1
+#endif
+// Derive the 480 PPQN sequencer tick from the audio sample counter
+// (SampleClock) instead of uClock's timer, so steps cannot drift against the
+// I2S clock and land on the same samples every run; 0 keeps uClock.
+#ifndef SEQUENCER_SAMPLE_CLOCK
+#define SEQUENCER_SAMPLE_CLOCK 0
+#endif
+
+// --- Audio latency profiles ---
+// The producer pool is allocated once for the largest profile. Smaller
+// profiles fill fewer samples per buffer and keep the spare buffers out of
+// circulation, so the profile can be switched while audio runs ('l' over
+// serial). I2S copies the producer buffers into short DMA buffers so they
+// add little on top of the profile.
+struct AudioLatencyProfile
+{
+    const char *name;
+    uint8_t buffers;
+    uint16_t samples;
+};
+const AudioLatencyProfile AUDIO_LATENCY_PROFILES[] = {
+    {"2x64", 2, 64},
+    {"3x128", 3, 128},
+    {"3x256", 3, 256},
+};
+constexpr uint8_t NUM_AUDIO_LATENCY_PROFILES = sizeof(AUDIO_LATENCY_PROFILES) / sizeof(AUDIO_LATENCY_PROFILES[0]);
+constexpr uint8_t DEFAULT_AUDIO_LATENCY_PROFILE = 2;
+constexpr int MAX_AUDIO_BUFFERS = 3;
+constexpr int MAX_SAMPLES_PER_BUFFER = 256;
+constexpr uint I2S_DMA_BUFFERS = 2;
+constexpr uint I2S_DMA_BUFFER_SAMPLES = 64;
+
 // --- Constants needed for template parameters ---
 constexpr float SAMPLE_RATE = 48000.0f;                                       // Compile-time constant for template parameters
 constexpr size_t MAX_DELAY_SAMPLES = static_cast<size_t>(SAMPLE_RATE * 1.8f);
@@ -35,7 +75,7 @@ uint8_t voice4Id = 0;
 
 // Global effects and delay (shared between voices)
 daisysp::Svf delLowPass;
-daisysp::DelayLine<float, MAX_DELAY_SAMPLES> del1;
+daisysp::DelayLine16<MAX_DELAY_SAMPLES> del1; // int16 ring, 2^17 samples (256 KB)
 float feedbackGain1 = 0.65f;
 float currentDelayOutputGain = 0.0f; // For smooth delay output fade
 OLEDDisplay display;
@@ -59,8 +99,9 @@ int IRQ_PIN = 1;
 int MAX_MIDI_NOTES = 16;
 float INT16_MAX_AS_FLOAT = 32767.0f;
 float INT16_MIN_AS_FLOAT = -32768.0f;
-int NUM_AUDIO_BUFFERS = 3;
-int SAMPLES_PER_BUFFER = 256;
+// Active audio latency profile; written by core0 when it switches profiles
+volatile int NUM_AUDIO_BUFFERS = 3;
+volatile int SAMPLES_PER_BUFFER = 256;
 float OSC_DETUNE_FACTOR = .001f;
 bool resetStepsLightsFlag = true;
 float delayTarget = 48000.0f * .15f;
@@ -78,6 +119,7 @@ void initOscillators();
 
 void updateParametersForStep(uint8_t stepToUpdate);
 void onStepCallback(uint32_t uClockCurrentStep);
+void runStep(uint32_t uClockCurrentStep, uint32_t stepSample);
 void applyEnvelopeParameters(const  VoiceState &state, daisysp::Adsr &env, int voiceNum);
 float calculateFilterFrequency(float filterValue);
 void setupI2SAudio(audio_format_t *audioFormat, audio_i2s_config_t *i2sConfig);
@@ -85,6 +127,8 @@ void setup();
 void setup1();
 void loop();
 void loop1();
+void handleSerialCommands();
+float framesToMs(uint64_t frames);
 
 // =======================
 //     GLOBAL VARIABLES
@@ -107,6 +151,35 @@ unsigned long previousMillis = 0;
 // MIDI note tracking is now handled by MidiNoteManager in src/midi/MidiManager.h
 audio_buffer_pool_t *producer_pool = nullptr;
 
+// Audio clock published by core0 at the start of every buffer: the sample
+// position (VoiceManager::getSampleTime()) and micros() when it was taken.
+// Odd audioClockSeq means an update is in progress (seqlock)
+std::atomic<uint32_t> audioClockSeq{0};
+volatile uint32_t audioClockSample = 0;
+volatile uint32_t audioClockMicros = 0;
+
+// Latency profile requested by core1 and the one core0 runs, plus the
+// producer buffers a smaller profile keeps out of circulation (core0 only)
+std::atomic<uint8_t> requestedLatencyProfile{DEFAULT_AUDIO_LATENCY_PROFILE};
+volatile uint8_t activeLatencyProfile = DEFAULT_AUDIO_LATENCY_PROFILE;
+audio_buffer_t *parkedAudioBuffers[MAX_AUDIO_BUFFERS];
+int parkedAudioBufferCount = 0;
+
+// Output latency: frames queued between core0 and the I2S DMA right after
+// each give, i.e. how long the last sample of that buffer waits before it
+// starts to play (the DMA buffer in flight adds up to I2S_DMA_BUFFER_SAMPLES).
+// Written by core0; reset on request from core1
+struct OutputLatencyStats
+{
+    uint32_t buffers;
+    uint32_t minFrames;
+    uint32_t maxFrames;
+    uint64_t sumFrames;
+};
+OutputLatencyStats outputLatency = {0, UINT32_MAX, 0, 0};
+uint32_t audioFramesGiven = 0;
+std::atomic<bool> outputLatencyResetRequested{false};
+
 volatile bool touchFlag = false;
 
 void touchInterrupt()
@@ -150,6 +223,14 @@ void onClockStart()
     seq2.start();
     seq3.start();
     seq4.start();
+#if SEQUENCER_SAMPLE_CLOCK
+    // The PLAY button calls this after onClockStop() halted the clock: pick
+    // tick generation up one buffer ahead, like a fresh start
+    if (!sampleClock.isRunning())
+    {
+        sampleClock.resume(voiceManager->getSampleTime() + static_cast<uint32_t>(SAMPLES_PER_BUFFER));
+    }
+#endif
     isClockRunning = true;
     unmuteOscillators();
 }
@@ -164,6 +245,11 @@ void onClockStop()
     seq3.stop();
     seq4.stop();
 
+#if SEQUENCER_SAMPLE_CLOCK
+    // No ticks (and so no steps or MIDI clock) until onClockStart()
+    sampleClock.stop();
+#endif
+
     // Use MidiNoteManager for comprehensive cleanup
     midiNoteManager.onSequencerStop();
 
@@ -178,6 +264,36 @@ void onClockStop()
 
 
 
+// --- Audio Clock ---
+// Core0 only
+static void publishAudioClock(uint32_t sample, uint32_t us)
+{
+    const uint32_t seq = audioClockSeq.load(std::memory_order_relaxed);
+    audioClockSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    audioClockSample = sample;
+    audioClockMicros = us;
+    audioClockSeq.store(seq + 2, std::memory_order_release);
+}
+
+// Any core: the sample core0 is rendering right now, extrapolated from the
+// last published buffer start (at most one buffer ahead of it)
+uint32_t estimateAudioSampleTime()
+{
+    uint32_t seq, sample, us;
+    do
+    {
+        seq = audioClockSeq.load(std::memory_order_acquire);
+        sample = audioClockSample;
+        us = audioClockMicros;
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((seq & 1u) || seq != audioClockSeq.load(std::memory_order_relaxed));
+
+    const uint32_t bufferUs = static_cast<uint32_t>(SAMPLES_PER_BUFFER * 1000000.0f / SAMPLE_RATE);
+    const uint32_t elapsedUs = std::min(static_cast<uint32_t>(micros() - us), bufferUs);
+    return sample + static_cast<uint32_t>(static_cast<uint64_t>(elapsedUs) * static_cast<uint32_t>(SAMPLE_RATE) / 1000000u);
+}
+
 // --- Audio Buffer Conversion ---
 static inline int16_t convertSampleToInt16(float sample)
 {
@@ -256,14 +372,41 @@ void applyVoicePreset(uint8_t voiceNumber, uint8_t presetIndex) {
 // isVoice2Mode is now managed by ButtonManager module
 const uint8_t VOICE2_LED_OFFSET = 32;                        // Starting LED index for Voice 2
 int currentThemeIndex = static_cast<int>(LEDTheme::DEFAULT); // Global variable for current theme
-// Somewhere accessible by both the ISR and loop1(), e.g., globally or in a class
- uint32_t ppqnTicksPending = 0;
+// PPQN ticks from the uClock ISR (or SampleClock) to loop1(), each stamped
+// with the audio sample it falls on. A stalled loop1() catches up on every
+// tick in order instead of losing or double-counting them, and knows how late
+// it is
+struct PpqnTick
+{
+    uint32_t tick;
+    uint32_t atSample;
+};
+constexpr size_t PPQN_TICK_QUEUE_SIZE = 512; // 210 ms of ticks at 300 BPM
+SpscQueue<PpqnTick, PPQN_TICK_QUEUE_SIZE> ppqnTicks;
+volatile uint32_t ppqnTicksDropped = 0;
+
+// How far behind loop1() handles ticks (core1 only)
+struct TickLagStats
+{
+    uint32_t ticks;
+    uint32_t maxLagUs;
+    uint64_t sumLagUs;
+    uint32_t maxBacklog; // most ticks handled in one loop1() pass
+};
+TickLagStats tickLag = {};
+
+void queuePpqnTick(uint32_t tick, uint32_t atSample)
+{
+    // Keep the ISR minimal: stamp and queue; a full queue drops the tick
+    if (!ppqnTicks.push(PpqnTick{tick, atSample}))
+    {
+        ppqnTicksDropped++;
+    }
+}
 
 void onOutputPPQNCallback(uint32_t tick)
 {
-    // Increment the counter to signal a pending tick
-    ppqnTicksPending++;
-    // That's it! Keep the ISR minimal.
+    queuePpqnTick(tick, estimateAudioSampleTime());
 }
 
 
@@ -373,13 +516,24 @@ void updateParametersForStep(uint8_t stepToUpdate) ///  This is the selected ste
     }
 }
 
+// Called from the uClock ISR (runStep) and from loop1() (UI edits through
+// updateActiveVoiceState()), both on core1: VoiceManager's command queue
+// takes a single producer core, and postCommand() masks core1's interrupts
+// so the two cannot interleave a push
 void updateVoiceParameters(
     const  VoiceState &state,
     bool isVoice2,
     bool updateGate = false,
     volatile bool *gate = nullptr,
-    volatile GateTimer *gateTimer = nullptr)
+    volatile GateTimer *gateTimer = nullptr,
+    uint32_t atSample = UINT32_MAX)
 {
+    // UINT32_MAX: no step time, apply as soon as possible
+    if (atSample == UINT32_MAX)
+    {
+        atSample = voiceManager->getSampleTime();
+    }
+
     // Handle gate timing and MIDI note events (sequencer playback mode only)
     if (updateGate && gate && gateTimer)
     {
@@ -446,35 +600,42 @@ void updateVoiceParameters(
         float baseFreq = daisysp::mtof(scale[currentScale][noteIndex] + 36 + state.octave);
 
         // Update voice frequency through VoiceManager
-        voiceManager->setVoiceFrequency(voiceId, baseFreq);
+        voiceManager->setVoiceFrequency(voiceId, baseFreq, atSample);
 
         // Handle slide/portamento
-        voiceManager->setVoiceSlide(voiceId, state.slide);
+        voiceManager->setVoiceSlide(voiceId, state.slide, atSample);
     }
 
     // Update all voice parameters through VoiceManager in single call
-    voiceManager->updateVoiceState(voiceId, state);
+    voiceManager->updateVoiceState(voiceId, state, atSample);
 
     // Send MIDI CC messages for parameter changes
     uint8_t midiVoiceId = isVoice2 ? 1 : 0;
 }
-// New helper to update a specific voice (1-4)
+// New helper to update a specific voice (1-4). Core1 only, like
+// updateVoiceParameters()
 void updateVoiceParametersForVoice(
     const VoiceState &state,
     uint8_t voiceNumber,
     bool updateGate = false,
     volatile bool *gate = nullptr,
-    volatile GateTimer *gateTimer = nullptr)
+    volatile GateTimer *gateTimer = nullptr,
+    uint32_t atSample = UINT32_MAX)
 {
     // For voices 1 and 2, reuse existing gate/MIDI logic; for 3/4 skip gates
     bool isVoice2 = (voiceNumber == 2);
 
     if (updateGate && (voiceNumber == 1 || voiceNumber == 2))
     {
-        updateVoiceParameters(state, isVoice2, updateGate, gate, gateTimer);
+        updateVoiceParameters(state, isVoice2, updateGate, gate, gateTimer, atSample);
         return;
     }
 
+    if (atSample == UINT32_MAX)
+    {
+        atSample = voiceManager->getSampleTime();
+    }
+
     // Map to actual VoiceManager voice IDs
     uint8_t voiceId;
     switch (voiceNumber)
@@ -490,11 +651,11 @@ void updateVoiceParametersForVoice(
     // Calculate base frequency for the voice
     int noteIndex = std::max(0, std::min(static_cast<int>(state.note), static_cast<int>(SCALE_STEPS - 1)));
     float baseFreq = daisysp::mtof(scale[currentScale][noteIndex] + 36 + state.octave);
-    voiceManager->setVoiceFrequency(voiceId, baseFreq);
-    voiceManager->setVoiceSlide(voiceId, state.slide);
+    voiceManager->setVoiceFrequency(voiceId, baseFreq, atSample);
+    voiceManager->setVoiceSlide(voiceId, state.slide, atSample);
 
     // Push full state to voice
-    voiceManager->updateVoiceState(voiceId, state);
+    voiceManager->updateVoiceState(voiceId, state, atSample);
 
     // Send MIDI CC only for voices 1 and 2
     if (voiceNumber == 1 || voiceNumber == 2)
@@ -556,6 +717,32 @@ void updateActiveVoiceState(uint8_t stepIndex, Sequencer &activeSeq)
 
 //  This gets called every 16th note
 void onStepCallback(uint32_t uClockCurrentStep)
+{
+    // Stamp the step one buffer after the sample being rendered now, so every
+    // voice of the step starts on the same sample instead of whenever core0
+    // next drains the command queue
+    runStep(uClockCurrentStep, estimateAudioSampleTime() + static_cast<uint32_t>(SAMPLES_PER_BUFFER));
+}
+
+// SampleClock callbacks (SEQUENCER_SAMPLE_CLOCK): run from loop1() with the
+// sample each tick falls on, up to one buffer ahead of core0
+void onSampleClockTick(uint32_t tick, uint32_t atSample)
+{
+    queuePpqnTick(tick, atSample);
+    if (tick % (PULSES_PER_QUARTER_NOTE / 24) == 0)
+    {
+        onSync24Callback(tick / (PULSES_PER_QUARTER_NOTE / 24));
+    }
+}
+
+void onSampleClockStep(uint32_t step, uint32_t atSample)
+{
+    runStep(step, atSample);
+}
+
+// Advances the sequencers by one step; every voice update takes effect on
+// stepSample (VoiceManager sample timeline)
+void runStep(uint32_t uClockCurrentStep, uint32_t stepSample)
 {
     currentSequencerStep = static_cast<uint8_t>(uClockCurrentStep); // Raw uClock step, sequencers handle their own modulo
 
@@ -585,10 +772,10 @@ void onStepCallback(uint32_t uClockCurrentStep)
     applyAS5600DelayValues();
 
     // 4. Update synth hardware (voices 1/2 with gates + MIDI; 3/4 audio only)
-    updateVoiceParametersForVoice(tempState1, 1, true, &GATE1, &gateTimer1);
-    updateVoiceParametersForVoice(tempState2, 2, true, &GATE2, &gateTimer2);
-    updateVoiceParametersForVoice(tempState3, 3, false);
-    updateVoiceParametersForVoice(tempState4, 4, false);
+    updateVoiceParametersForVoice(tempState1, 1, true, &GATE1, &gateTimer1, stepSample);
+    updateVoiceParametersForVoice(tempState2, 2, true, &GATE2, &gateTimer2, stepSample);
+    updateVoiceParametersForVoice(tempState3, 3, false, nullptr, nullptr, stepSample);
+    updateVoiceParametersForVoice(tempState4, 4, false, nullptr, nullptr, stepSample);
 
     // Store states
     voiceState1 = tempState1;
@@ -599,9 +786,10 @@ void onStepCallback(uint32_t uClockCurrentStep)
 
 void fill_audio_buffer(audio_buffer_t *buffer)
 {
-    int N = buffer->max_sample_count;
+    PROF_BUFFER_BEGIN();
+    publishAudioClock(voiceManager->getSampleTime(), micros());
+    int N = std::min(static_cast<int>(SAMPLES_PER_BUFFER), static_cast<int>(buffer->max_sample_count));
     int16_t *out = reinterpret_cast<int16_t *>(buffer->buffer->bytes);
-    float finalvoice;
     float output;
 
     // Determine the target gains based on delayOn state
@@ -617,20 +805,46 @@ void fill_audio_buffer(audio_buffer_t *buffer)
     del1.SetDelay(currentDelay);
 
 
+#if VOICE_BLOCK_PROCESSING
+    // Render the voices a block at a time, then run delay and output per sample
+    float voiceBlock[Voice::MAX_BLOCK_SIZE];
+    for (int blockStart = 0; blockStart < N; blockStart += Voice::MAX_BLOCK_SIZE)
+    {
+        const int blockSize = std::min(N - blockStart, static_cast<int>(Voice::MAX_BLOCK_SIZE));
+        voiceManager->processAllVoicesBlock(voiceBlock, blockSize);
+
+        PROF_SHARED();
+        PROF_START(profT);
+        for (int j = 0; j < blockSize; ++j)
+        {
+            const int i = blockStart + j;
+            output = processDelayEffect(voiceBlock[j]);
+            float softLimitedOutput = daisysp::SoftLimit(output);
+            out[2 * i + 0] = convertSampleToInt16(softLimitedOutput * 0.5f);
+            out[2 * i + 1] = convertSampleToInt16(softLimitedOutput * 0.5f);
+        }
+        PROF_LAP(Delay, profT);
+    }
+#else
     for (int i = 0; i < N; ++i)
     {
         // Process all voices efficiently (voice states are updated by sequencer callbacks)
-        finalvoice = voiceManager->processAllVoices();
+        float finalvoice = voiceManager->processAllVoices();
 
         // Process delay effect
+        PROF_SHARED();
+        PROF_START(profT);
         output = processDelayEffect(finalvoice);
+        PROF_LAP(Delay, profT);
         float softLimitedOutput = daisysp::SoftLimit(output);
         // Output to stereo channels
         out[2 * i + 0] = convertSampleToInt16(softLimitedOutput * 0.5f);
         out[2 * i + 1] = convertSampleToInt16(softLimitedOutput * 0.5f);
     }
+#endif
 
     buffer->sample_count = N;
+    PROF_BUFFER_END();
 }
 
 // --- Delay Effect Processing ---
@@ -643,8 +857,7 @@ float processDelayEffect(float inputSignal)
     float feedbackSignal = delout * currentFeedbackGain;
 
     // Apply low-pass filtering to feedback to prevent harsh artifacts
-    delLowPass.Process(feedbackSignal);
-    float filteredFeedback = delLowPass.Low();
+    float filteredFeedback = delLowPass.Process<daisysp::Svf::Output::Low>(feedbackSignal);
 
     // Write to delay line: dry input + filtered feedback
     // Clamp feedback to prevent runaway
@@ -663,7 +876,7 @@ void setupI2SAudio(audio_format_t *audioFormat, audio_i2s_config_t *i2sConfig)
         g_errorState |= ERR_AUDIO;
         return;
     }
-    if (!audio_i2s_connect(producer_pool))
+    if (!audio_i2s_connect_extra(producer_pool, false, I2S_DMA_BUFFERS, I2S_DMA_BUFFER_SAMPLES, nullptr))
     {
         g_errorState |= ERR_AUDIO;
         return;
@@ -684,7 +897,10 @@ void setup()
     static audio_buffer_format_t bufferFormat = {
         .format = &audioFormat,
         .sample_stride = 4};
-    producer_pool = audio_new_producer_pool(&bufferFormat, NUM_AUDIO_BUFFERS, SAMPLES_PER_BUFFER);
+    NUM_AUDIO_BUFFERS = AUDIO_LATENCY_PROFILES[DEFAULT_AUDIO_LATENCY_PROFILE].buffers;
+    SAMPLES_PER_BUFFER = AUDIO_LATENCY_PROFILES[DEFAULT_AUDIO_LATENCY_PROFILE].samples;
+    producer_pool = audio_new_producer_pool(&bufferFormat, MAX_AUDIO_BUFFERS, MAX_SAMPLES_PER_BUFFER);
+    AudioProfiler::begin(SAMPLES_PER_BUFFER, SAMPLE_RATE);
     audio_i2s_config_t i2sConfig = {
         .data_pin = PICO_AUDIO_I2S_DATA_PIN,
         .clock_pin_base = PICO_AUDIO_I2S_CLOCK_PIN_BASE,
@@ -796,6 +1012,16 @@ void setup1()
         matrixEventHandler(evt, uiState, seqs, 4, midiNoteManager);
     });
 
+#if SEQUENCER_SAMPLE_CLOCK
+    sampleClock.init(SAMPLE_RATE);
+    sampleClock.setOnTick(onSampleClockTick);
+    sampleClock.setOnStep(onSampleClockStep);
+    sampleClock.setTempo(90);
+    sampleClock.setShuffle(true);
+    sampleClock.start(voiceManager->getSampleTime() + static_cast<uint32_t>(SAMPLES_PER_BUFFER));
+    // uClock.start() calls this itself
+    onClockStart();
+#else
     uClock.init();
     uClock.setOnSync24(onSync24Callback);
     uClock.setOnClockStart(onClockStart);
@@ -806,6 +1032,7 @@ void setup1()
     uClock.setTempo(90);
     uClock.start();
     uClock.setShuffle(true);
+#endif
     seq1.start();
     seq2.start();
 
@@ -814,16 +1041,227 @@ void setup1()
 }
 
 // --- Audio Loop (Core0) ---
+void resetOutputLatency()
+{
+    outputLatency = {0, UINT32_MAX, 0, 0};
+}
+
+// Core0: switch to another latency profile between two buffers
+void applyLatencyProfile(uint8_t index)
+{
+    const AudioLatencyProfile &profile = AUDIO_LATENCY_PROFILES[index];
+    NUM_AUDIO_BUFFERS = profile.buffers;
+    SAMPLES_PER_BUFFER = profile.samples;
+    activeLatencyProfile = index;
+
+    // Return buffers the new profile uses again; loop() parks any extra ones
+    while (parkedAudioBufferCount > MAX_AUDIO_BUFFERS - NUM_AUDIO_BUFFERS)
+    {
+        queue_free_audio_buffer(producer_pool, parkedAudioBuffers[--parkedAudioBufferCount]);
+    }
+    AudioProfiler::begin(SAMPLES_PER_BUFFER, SAMPLE_RATE);
+    resetOutputLatency();
+}
+
 void loop()
 {
+    const uint8_t requested = requestedLatencyProfile.load(std::memory_order_relaxed);
+    if (requested != activeLatencyProfile && requested < NUM_AUDIO_LATENCY_PROFILES)
+    {
+        applyLatencyProfile(requested);
+    }
+    if (outputLatencyResetRequested.exchange(false))
+    {
+        resetOutputLatency();
+    }
+
     audio_buffer_t *buf = take_audio_buffer(producer_pool, true);
     if (buf)
     {
+        if (parkedAudioBufferCount < MAX_AUDIO_BUFFERS - NUM_AUDIO_BUFFERS)
+        {
+            parkedAudioBuffers[parkedAudioBufferCount++] = buf;
+            return;
+        }
         fill_audio_buffer(buf);
+        const uint32_t frames = buf->sample_count;
         give_audio_buffer(producer_pool, buf);
+
+        audioFramesGiven += frames;
+        const uint32_t queued = audioFramesGiven - audio_i2s_get_frames_started();
+        outputLatency.buffers++;
+        outputLatency.sumFrames += queued;
+        outputLatency.minFrames = std::min(outputLatency.minFrames, queued);
+        outputLatency.maxFrames = std::max(outputLatency.maxFrames, queued);
     }
- 
+}
 
+// --- Serial Diagnostics (Core1) ---
+void printAudioPoolStats()
+{
+    if (!producer_pool)
+    {
+        Serial.println("[AUDIO] no producer pool");
+        return;
+    }
+    audio_buffer_pool_stats_t stats;
+    audio_buffer_pool_get_stats(producer_pool, &stats);
+    Serial.printf("[AUDIO] underruns %lu, short %lu, late %lu of %lu buffers\n",
+                  static_cast<unsigned long>(stats.underruns), static_cast<unsigned long>(stats.short_buffers),
+                  static_cast<unsigned long>(stats.late_buffers), static_cast<unsigned long>(stats.buffers_given));
+    Serial.printf("[AUDIO] worst give interval %lu us, min depth free %u / prepared %u\n",
+                  static_cast<unsigned long>(stats.max_give_interval_us), static_cast<unsigned>(stats.min_free_depth),
+                  static_cast<unsigned>(stats.min_prepared_depth));
+
+    // Snapshot of core0's counters; a buffer given meanwhile may be half counted
+    const OutputLatencyStats latency = outputLatency;
+    const AudioLatencyProfile &profile = AUDIO_LATENCY_PROFILES[activeLatencyProfile];
+    Serial.printf("[AUDIO] profile %s, output latency min/avg/max %.2f/%.2f/%.2f ms over %lu buffers\n",
+                  profile.name, static_cast<double>(framesToMs(latency.buffers ? latency.minFrames : 0)),
+                  static_cast<double>(latency.buffers ? framesToMs(latency.sumFrames) / latency.buffers : 0.0f),
+                  static_cast<double>(framesToMs(latency.maxFrames)), static_cast<unsigned long>(latency.buffers));
+}
+
+void printTickLagStats()
+{
+    Serial.printf("[CLOCK] %lu ticks, lag avg %lu us max %lu us, backlog max %lu now %u, dropped %lu\n",
+                  static_cast<unsigned long>(tickLag.ticks),
+                  static_cast<unsigned long>(tickLag.ticks ? tickLag.sumLagUs / tickLag.ticks : 0),
+                  static_cast<unsigned long>(tickLag.maxLagUs), static_cast<unsigned long>(tickLag.maxBacklog),
+                  static_cast<unsigned>(ppqnTicks.size()), static_cast<unsigned long>(ppqnTicksDropped));
+}
+
+float framesToMs(uint64_t frames)
+{
+    return static_cast<float>(frames) * 1000.0f / SAMPLE_RATE;
+}
+
+void resetAudioStats()
+{
+    if (producer_pool)
+    {
+        audio_buffer_pool_reset_stats(producer_pool);
+    }
+    outputLatencyResetRequested.store(true);
+}
+
+// Latency sweep ('L'): runs every profile for LATENCY_SWEEP_MS after letting
+// it settle, prints one row of achieved latency and underrun rate per
+// profile, then returns to the profile that was active before
+const unsigned long LATENCY_SWEEP_SETTLE_MS = 500;
+const unsigned long LATENCY_SWEEP_MS = 10000;
+int8_t latencySweepIndex = -1;
+bool latencySweepSettled = false;
+unsigned long latencySweepPhaseStart = 0;
+uint8_t latencySweepRestore = DEFAULT_AUDIO_LATENCY_PROFILE;
+
+void startLatencySweepProfile(uint8_t index)
+{
+    latencySweepIndex = static_cast<int8_t>(index);
+    latencySweepSettled = false;
+    latencySweepPhaseStart = millis();
+    requestedLatencyProfile.store(index);
+}
+
+void updateLatencySweep()
+{
+    if (latencySweepIndex < 0)
+    {
+        return;
+    }
+    const unsigned long now = millis();
+    if (!latencySweepSettled)
+    {
+        if (now - latencySweepPhaseStart >= LATENCY_SWEEP_SETTLE_MS && activeLatencyProfile == latencySweepIndex)
+        {
+            resetAudioStats();
+            latencySweepSettled = true;
+            latencySweepPhaseStart = now;
+        }
+        return;
+    }
+    if (now - latencySweepPhaseStart < LATENCY_SWEEP_MS)
+    {
+        return;
+    }
+
+    audio_buffer_pool_stats_t stats;
+    audio_buffer_pool_get_stats(producer_pool, &stats);
+    const OutputLatencyStats latency = outputLatency;
+    const AudioLatencyProfile &profile = AUDIO_LATENCY_PROFILES[latencySweepIndex];
+    const float minutes = static_cast<float>(now - latencySweepPhaseStart) / 60000.0f;
+    Serial.printf("[AUDIO] %-6s %6.2f %6.2f %6.2f %6.2f %9lu %8.1f %6lu\n", profile.name,
+                  static_cast<double>(framesToMs(static_cast<uint64_t>(profile.buffers) * profile.samples + I2S_DMA_BUFFER_SAMPLES)),
+                  static_cast<double>(framesToMs(latency.buffers ? latency.minFrames : 0)),
+                  static_cast<double>(latency.buffers ? framesToMs(latency.sumFrames) / latency.buffers : 0.0f),
+                  static_cast<double>(framesToMs(latency.maxFrames)), static_cast<unsigned long>(stats.underruns),
+                  static_cast<double>(stats.underruns / minutes), static_cast<unsigned long>(stats.short_buffers));
+
+    if (latencySweepIndex + 1 < NUM_AUDIO_LATENCY_PROFILES)
+    {
+        startLatencySweepProfile(static_cast<uint8_t>(latencySweepIndex + 1));
+    }
+    else
+    {
+        latencySweepIndex = -1;
+        requestedLatencyProfile.store(latencySweepRestore);
+        Serial.println("[AUDIO] latency sweep done");
+    }
+}
+
+// 'u' prints the audio buffer pool counters, 'U' prints and clears them.
+// 'l' switches to the next audio latency profile, 'L' measures all of them.
+// 't' prints how far behind loop1() handles clock ticks, 'T' prints and clears it.
+// With AUDIO_PROFILER_COMPILED, 'p' prints the load report, 'r' prints and resets it.
+void handleSerialCommands()
+{
+    while (Serial.available() > 0)
+    {
+        const int cmd = Serial.read();
+        if (cmd == 'u' || cmd == 'U')
+        {
+            printAudioPoolStats();
+            if (cmd == 'U')
+            {
+                resetAudioStats();
+            }
+        }
+        else if (cmd == 't' || cmd == 'T')
+        {
+            printTickLagStats();
+            if (cmd == 'T')
+            {
+                tickLag = {};
+                ppqnTicksDropped = 0;
+            }
+        }
+        else if (cmd == 'l' && latencySweepIndex < 0)
+        {
+            const uint8_t next = (requestedLatencyProfile.load() + 1) % NUM_AUDIO_LATENCY_PROFILES;
+            requestedLatencyProfile.store(next);
+            resetAudioStats();
+            Serial.printf("[AUDIO] latency profile %s\n", AUDIO_LATENCY_PROFILES[next].name);
+        }
+        else if (cmd == 'L' && latencySweepIndex < 0 && producer_pool)
+        {
+            latencySweepRestore = requestedLatencyProfile.load();
+            Serial.printf("[AUDIO] latency sweep, %lu s per profile (ms; underruns per minute)\n",
+                          LATENCY_SWEEP_MS / 1000);
+            Serial.printf("[AUDIO] %-6s %6s %6s %6s %6s %9s %8s %6s\n", "prof", "nomin", "min", "avg", "max",
+                          "underruns", "per min", "short");
+            startLatencySweepProfile(0);
+        }
+#if AUDIO_PROFILER_COMPILED
+        else if (cmd == 'p' || cmd == 'r')
+        {
+            AudioProfiler::requestReport(cmd == 'r');
+        }
+#endif
+    }
+    updateLatencySweep();
+#if AUDIO_PROFILER_COMPILED
+    AudioProfiler::printRequestedReport();
+#endif
 }
 
 // --- LED, Display and UI Update Loop (Core1) ---
@@ -832,22 +1270,49 @@ void loop1()
 
     usb_midi.read();
     pollUIHeldButtons(uiState, seq1, seq2);
+    handleSerialCommands();
 
     unsigned long currentMillis = millis();
 
     // Check if any parameter buttons are held 
     bool parameterRecordingActive = isAnyParameterButtonHeld(uiState);
 
-
-
-    // Process all pending PPQN ticks
+#if SEQUENCER_UNROLLED_CYCLE
+    // Re-unroll any pattern edited since the last pass; the clock reads the
+    // tracks directly until this has caught up
+    seq1.updateUnrolledCycle();
+    seq2.updateUnrolledCycle();
+    seq3.updateUnrolledCycle();
+    seq4.updateUnrolledCycle();
+#endif
+
+#if SEQUENCER_SAMPLE_CLOCK
+    // Generate every tick and step due before the end of the buffer after
+    // the one core0 is rendering; their voice commands are stamped with
+    // exact sample times, so they land on time however late in that window
+    // this runs
+    sampleClock.advanceTo(voiceManager->getSampleTime() + static_cast<uint32_t>(SAMPLES_PER_BUFFER));
+#endif
+
+    // Process all pending PPQN ticks, oldest first
     static uint16_t globalTickCounter = 0; // Global tick counter for MidiNoteManager
 
-    while (ppqnTicksPending > 0)
+    uint32_t backlog = 0;
+    PpqnTick pending;
+    while (ppqnTicks.pop(pending))
     {
-        // Decrement the counter *before* processing the tick
-        ppqnTicksPending--;
         globalTickCounter++;
+        backlog++;
+
+        // Ticks SampleClock generated ahead of core0 are not late yet
+        const int32_t lagSamples = static_cast<int32_t>(estimateAudioSampleTime() - pending.atSample);
+        const uint32_t lagUs = lagSamples > 0
+                                   ? static_cast<uint32_t>(static_cast<uint64_t>(lagSamples) * 1000000u /
+                                                           static_cast<uint32_t>(SAMPLE_RATE))
+                                   : 0;
+        tickLag.ticks++;
+        tickLag.sumLagUs += lagUs;
+        tickLag.maxLagUs = std::max(tickLag.maxLagUs, lagUs);
 
         // Update MidiNoteManager timing - this handles all MIDI note-off timing
         midiNoteManager.updateTiming(globalTickCounter);
@@ -874,6 +1339,7 @@ void loop1()
 
        
     }
+    tickLag.maxBacklog = std::max(tickLag.maxBacklog, backlog);
 
 
     static unsigned long lastLEDUpdate = 0;
@@ -17,7 +17,7 @@
 #include "src/dsp/ladder.h"
 #include "src/dsp/svf.h"
 #include "src/dsp/oscillator.h"
-#include "src/dsp/delayline.h"
+#include "src/dsp/delayline16.h"
 #include "src/scales/scales.h"
 #include "src/dsp/wavefolder.h"
 #include "src/dsp/overdrive.h"
@@ -27,6 +27,7 @@
 #include "src/matrix/Matrix.h"
 #include "src/sequencer/Sequencer.h"
 #include "src/sequencer/SequencerDefs.h"
+#include "src/sequencer/SampleClock.h"
 
 // LED Matrix
 #include "src/LEDMatrix/ledMatrix.h"
@@ -362,12 +362,15 @@ static void renderVoicePair(
         return;
     }
 
+    const PackedStep* stepsA = a.getPackedSteps();
+    const PackedStep* stepsB = b.getPackedSteps();
+
     for (int step = 0; step < 16; ++step) {
         // Top row voice (first voice in pair)
-        const Step& sa = a.getStep(step);
+        const PackedStep& sa = stepsA[step];
         bool phA = (a.getCurrentStepForParameter(ParamId::Gate) == step && a.isRunning());
-        CRGB colorA = sa.gate ? theme->gateOnV1 : theme->gateOffV1;
-        if (a.getStepParameterValue(ParamId::Slide, step) > 0) { 
+        CRGB colorA = sa.gate() ? theme->gateOnV1 : theme->gateOffV1;
+        if (sa.slide()) { 
             nblend(colorA, theme->modSlideActive, 128); 
         }
         if (phA) { 
@@ -380,10 +383,10 @@ static void renderVoicePair(
         nblend(ledMatrix.getLeds()[topRowIndex], smoothedTargetColors[topRowIndex], 166);
 
         // Bottom row voice (second voice in pair)
-        const Step& sb = b.getStep(step);
+        const PackedStep& sb = stepsB[step];
         bool phB = (b.getCurrentStepForParameter(ParamId::Gate) == step && b.isRunning());
-        CRGB colorB = sb.gate ? theme->gateOnV2 : theme->gateOffV2;
-        if (b.getStepParameterValue(ParamId::Slide, step) > 0) { 
+        CRGB colorB = sb.gate() ? theme->gateOnV2 : theme->gateOffV2;
+        if (sb.slide()) { 
             nblend(colorB, theme->modSlideActive, 128); 
         }
         if (phB) { 
@@ -426,16 +429,17 @@ void updateGateLEDs(
     } else {
         // --- Active Sequencing Mode ---
         // For each step, update the LED color based on gate, slide, and playhead status for both voices.
+        const PackedStep* steps1 = seq1.getPackedSteps();
+        const PackedStep* steps2 = seq2.getPackedSteps();
         for (int step = 0; step < 16; ++step) {
             // --- Voice 1 (seq1) ---
-            const Step& s1 = seq1.getStep(step);
+            const PackedStep& s1 = steps1[step];
             bool isPlayhead1 = (seq1.getCurrentStepForParameter(ParamId::Gate) == step && seq1.isRunning());
             // Choose color based on gate state
-            CRGB targetColor1 = s1.gate ? activeThemeColors->gateOnV1 : activeThemeColors->gateOffV1;
+            CRGB targetColor1 = s1.gate() ? activeThemeColors->gateOnV1 : activeThemeColors->gateOffV1;
 
             // If slide is active for this step, blend in the slide accent color
-            uint8_t slideValue1 = seq1.getStepParameterValue(ParamId::Slide, step);
-            if (slideValue1 > 0) {
+            if (s1.slide()) {
                 nblend(targetColor1, activeThemeColors->modSlideActive, 128);
             }
 
@@ -449,12 +453,11 @@ void updateGateLEDs(
             nblend(ledMatrix.getLeds()[step], smoothedTargetColors[step], 166);
 
             // --- Voice 2 (seq2) ---
-            const Step& s2 = seq2.getStep(step);
+            const PackedStep& s2 = steps2[step];
             bool isPlayhead2 = (seq2.getCurrentStepForParameter(ParamId::Gate) == step && seq2.isRunning());
-            CRGB targetColor2 = s2.gate ? activeThemeColors->gateOnV2 : activeThemeColors->gateOffV2;
+            CRGB targetColor2 = s2.gate() ? activeThemeColors->gateOnV2 : activeThemeColors->gateOffV2;
 
-            uint8_t slideValue2 = seq2.getStepParameterValue(ParamId::Slide, step);
-            if (slideValue2 > 0) {
+            if (s2.slide()) {
                 nblend(targetColor2, activeThemeColors->modSlideActive, 128);
             }
 
@@ -502,10 +505,10 @@ void updateStepLEDs(
         const Sequencer& activeSeq = *seqPtr;
         uint8_t slidePlayhead = activeSeq.getCurrentStepForParameter(ParamId::Slide);
         uint8_t slideLength = activeSeq.getParameterStepCount(ParamId::Slide);
+        const PackedStep* steps = activeSeq.getPackedSteps();
 
         for (int step = 0; step < NUMBER_OF_STEP_BUTTONS; step++) {
-            uint8_t slideValue = activeSeq.getStepParameterValue(ParamId::Slide, step);
-            bool isSlideActive = (slideValue > 0);
+            bool isSlideActive = steps[step].slide();
             bool isPlayhead = (step == slidePlayhead);
             bool isWithinLength = (step < slideLength);
 
@@ -770,6 +770,7 @@ void OLEDDisplay::drawStepIndicators(const Sequencer& seq, int y) {
     if (stepCount == 0) stepCount = 16;
 
     const uint8_t cur = seq.getCurrentStep();
+    const PackedStep* steps = seq.getPackedSteps();
     const int left = 4;
     const int right = SCREEN_WIDTH - 4;
     const int width = right - left;
@@ -779,8 +780,7 @@ void OLEDDisplay::drawStepIndicators(const Sequencer& seq, int y) {
         int nextX = left + ((i + 1) * width) / stepCount;
         int w = max(2, nextX - x - 1);
 
-        float gate = seq.getStepParameterValue(ParamId::Gate, i);
-        bool on = gate > 0.5f;
+        bool on = steps[i].gate();
         bool isCur = (i == cur);
         int h = isCur ? 6 : (on ? 4 : 3); // Make gate-off bars a touch taller
 
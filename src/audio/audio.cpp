@@ -7,6 +7,7 @@
 
 #include <cstring>
 #include "audio.h"
+#include "hardware/timer.h"
 #include "sample_conversion.h"
 
 // ======================
@@ -81,6 +82,11 @@ audio_buffer_t *get_free_audio_buffer(audio_buffer_pool_t *context, bool block)
     do {
         uint32_t save = spin_lock_blocking(context->free_list_spin_lock);
         ab = list_remove_head(&context->free_list);
+        if (ab) {
+            context->free_depth--;
+            if (context->free_depth < context->stats.min_free_depth)
+                context->stats.min_free_depth = context->free_depth;
+        }
         spin_unlock(context->free_list_spin_lock, save);
         if (ab || !block) break;
         __wfe();
@@ -92,6 +98,7 @@ void queue_free_audio_buffer(audio_buffer_pool_t *context, audio_buffer_t *ab) {
     assert(!ab->next);
     uint32_t save = spin_lock_blocking(context->free_list_spin_lock);
     list_prepend(&context->free_list, ab);
+    context->free_depth++;
     spin_unlock(context->free_list_spin_lock, save);
     __sev();
 }
@@ -102,6 +109,11 @@ audio_buffer_t *get_full_audio_buffer(audio_buffer_pool_t *context, bool block)
     do {
         uint32_t save = spin_lock_blocking(context->prepared_list_spin_lock);
         ab = list_remove_head_with_tail(&context->prepared_list, &context->prepared_list_tail);
+        if (ab) {
+            context->prepared_depth--;
+            if (context->prepared_depth < context->stats.min_prepared_depth)
+                context->stats.min_prepared_depth = context->prepared_depth;
+        }
         spin_unlock(context->prepared_list_spin_lock, save);
         if (ab || !block) break;
         __wfe();
@@ -113,6 +125,7 @@ void queue_full_audio_buffer(audio_buffer_pool_t *context, audio_buffer_t *ab) {
     assert(!ab->next);
     uint32_t save = spin_lock_blocking(context->prepared_list_spin_lock);
     list_append_with_tail(&context->prepared_list, &context->prepared_list_tail, ab);
+    context->prepared_depth++;
     spin_unlock(context->prepared_list_spin_lock, save);
     __sev();
 }
@@ -169,7 +182,11 @@ audio_new_buffer_pool(audio_buffer_format_t *format, int buffer_count, int buffe
     ac->prepared_list_spin_lock = spin_lock_init(SPINLOCK_ID_AUDIO_PREPARED_LISTS_LOCK);
     ac->prepared_list = NULL;
     ac->prepared_list_tail = NULL;
+    ac->free_depth = (uint16_t) buffer_count;
+    ac->prepared_depth = 0;
+    ac->giving = false;
     ac->connection = &connection_default;
+    audio_buffer_pool_reset_stats(ac);
     return ac;
 }
 
@@ -210,12 +227,31 @@ void audio_complete_connection(audio_connection_t *connection, audio_buffer_pool
     connection->consumer_pool = consumer_pool;
 }
 
+// Time between gives. One period of slack absorbs the jitter of a producer
+// that is keeping up; a give more than two periods after the last one means
+// it fell behind real time and the prepared list shrank
+static void record_give(audio_buffer_pool_t *ac, const audio_buffer_t *buffer) {
+    const uint32_t now = time_us_32();
+    uint32_t save = spin_lock_blocking(ac->prepared_list_spin_lock);
+    if (ac->giving) {
+        const uint32_t interval = now - ac->last_give_us;
+        const uint32_t period = (uint32_t) ((uint64_t) buffer->sample_count * 1000000u / ac->format->sample_freq);
+        if (interval > ac->stats.max_give_interval_us) ac->stats.max_give_interval_us = interval;
+        if (interval > 2 * period) ac->stats.late_buffers++;
+    }
+    ac->giving = true;
+    ac->last_give_us = now;
+    ac->stats.buffers_given++;
+    spin_unlock(ac->prepared_list_spin_lock, save);
+}
+
 void give_audio_buffer(audio_buffer_pool_t *ac, audio_buffer_t *buffer) {
     buffer->user_data = 0;
     assert(ac->connection);
-    if (ac->type == audio_buffer_pool::ac_producer)
+    if (ac->type == audio_buffer_pool::ac_producer) {
+        record_give(ac, buffer);
         ac->connection->producer_pool_give(ac->connection, buffer);
-    else
+    } else
         ac->connection->consumer_pool_give(ac->connection, buffer);
 }
 
@@ -223,8 +259,40 @@ audio_buffer_t *take_audio_buffer(audio_buffer_pool_t *ac, bool block) {
     assert(ac->connection);
     if (ac->type == audio_buffer_pool::ac_producer)
         return ac->connection->producer_pool_take(ac->connection, block);
-    else
-        return ac->connection->consumer_pool_take(ac->connection, block);
+
+    audio_buffer_t *ab = ac->connection->consumer_pool_take(ac->connection, block);
+    audio_buffer_pool_t *producer = ac->connection->producer_pool;
+    if (producer) {
+        // The consumer (the I2S DMA IRQ) plays silence when it gets nothing;
+        // before the producer's first buffer that is just startup
+        uint32_t save = spin_lock_blocking(producer->prepared_list_spin_lock);
+        if (producer->giving) {
+            if (!ab)
+                producer->stats.underruns++;
+            else if (ab->sample_count < ab->max_sample_count)
+                producer->stats.short_buffers++;
+        }
+        spin_unlock(producer->prepared_list_spin_lock, save);
+    }
+    return ab;
+}
+
+void audio_buffer_pool_get_stats(audio_buffer_pool_t *ac, audio_buffer_pool_stats_t *stats) {
+    uint32_t save = spin_lock_blocking(ac->free_list_spin_lock);
+    uint32_t save_prepared = spin_lock_blocking(ac->prepared_list_spin_lock);
+    *stats = ac->stats;
+    spin_unlock(ac->prepared_list_spin_lock, save_prepared);
+    spin_unlock(ac->free_list_spin_lock, save);
+}
+
+void audio_buffer_pool_reset_stats(audio_buffer_pool_t *ac) {
+    uint32_t save = spin_lock_blocking(ac->free_list_spin_lock);
+    uint32_t save_prepared = spin_lock_blocking(ac->prepared_list_spin_lock);
+    memset(&ac->stats, 0, sizeof(ac->stats));
+    ac->stats.min_free_depth = ac->free_depth;
+    ac->stats.min_prepared_depth = ac->prepared_depth;
+    spin_unlock(ac->prepared_list_spin_lock, save_prepared);
+    spin_unlock(ac->free_list_spin_lock, save);
 }
 
 // todo rename this - this is s16 to s16
@@ -73,6 +73,21 @@ typedef struct audio_buffer {
 
 typedef struct audio_connection audio_connection_t;
 
+/** \brief Buffer pool telemetry, see audio_buffer_pool_get_stats()
+ *
+ * Underrun and short buffer counts are kept on the producer pool of a
+ * connection, since it is the producer that failed to keep up.
+ */
+typedef struct audio_buffer_pool_stats {
+    uint32_t underruns;            ///< consumer takes that found no prepared buffer (silence was played)
+    uint32_t short_buffers;        ///< consumer takes only partly filled from prepared buffers
+    uint32_t late_buffers;         ///< gives more than two buffer periods after the previous give
+    uint32_t buffers_given;        ///< gives since the last reset
+    uint32_t max_give_interval_us; ///< worst time between two gives
+    uint16_t min_free_depth;       ///< fewest buffers seen on the free list
+    uint16_t min_prepared_depth;   ///< fewest buffers seen on the prepared list
+} audio_buffer_pool_stats_t;
+
 typedef struct audio_buffer_pool {
     enum {
         ac_producer, ac_consumer
@@ -86,6 +101,13 @@ typedef struct audio_buffer_pool {
     spin_lock_t *prepared_list_spin_lock;
     audio_buffer_t *prepared_list;
     audio_buffer_t *prepared_list_tail;
+    // ----- telemetry; list depths and min depths are protected by the matching
+    // list lock, everything else by prepared_list_spin_lock -----
+    uint16_t free_depth;
+    uint16_t prepared_depth;
+    uint32_t last_give_us;
+    bool giving; // set by the first give; takes before it are startup, not underruns
+    audio_buffer_pool_stats_t stats;
 } audio_buffer_pool_t;
 
 typedef struct audio_connection audio_connection_t;
@@ -168,6 +190,25 @@ void give_audio_buffer(audio_buffer_pool_t *ac, audio_buffer_t *buffer);
  */
 audio_buffer_t *take_audio_buffer(audio_buffer_pool_t *ac, bool block);
 
+/*! \brief Copy the telemetry counters of a buffer pool
+ *  \ingroup pico_audio
+ *
+ * Safe to call from either core while audio is running.
+ *
+ * \param ac Pool to query (normally the producer pool passed to the connection)
+ * \param stats Receives the counters
+ */
+void audio_buffer_pool_get_stats(audio_buffer_pool_t *ac, audio_buffer_pool_stats_t *stats);
+
+/*! \brief Clear the telemetry counters of a buffer pool
+ *  \ingroup pico_audio
+ *
+ * The minimum depths restart from the current list depths.
+ *
+ * \param ac Pool to reset
+ */
+void audio_buffer_pool_reset_stats(audio_buffer_pool_t *ac);
+
 /*! \brief \todo
  *  \ingroup pico_audio
  *
@@ -35,6 +35,7 @@ CU_REGISTER_DEBUG_PINS(audio_timing)
 struct {
     audio_buffer_t *playing_buffer;
     uint32_t freq;
+    volatile uint32_t frames_started; // frames of real (non-silence) buffers handed to DMA
     uint8_t pio_sm;
     uint8_t dma_channel;
 } shared_state;
@@ -343,6 +344,11 @@ static inline void audio_start_dma_transfer() {
     channel_config_set_read_increment(&c, true);
     dma_channel_set_config(shared_state.dma_channel, &c, false);
     dma_channel_transfer_from_buffer_now(shared_state.dma_channel, ab->buffer->bytes, ab->sample_count);
+    shared_state.frames_started += ab->sample_count;
+}
+
+uint32_t audio_i2s_get_frames_started(void) {
+    return shared_state.frames_started;
 }
 
 // irq handler for DMA
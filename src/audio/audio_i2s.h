@@ -175,6 +175,17 @@ bool audio_i2s_connect_extra(audio_buffer_pool_t *producer, bool buffer_on_give,
  */
 void audio_i2s_set_enabled(bool enabled);
 
+/** \brief Count of audio frames handed to the I2S DMA so far
+ * \ingroup pico_audio_i2s
+ *
+ * Only frames from real buffers count, not the silence played on an
+ * underrun, so the difference to the frames given to the producer pool is
+ * what is still queued between the producer and the DAC. Wraps at 2^32.
+ *
+ * \return Frames started since audio was enabled
+ */
+uint32_t audio_i2s_get_frames_started(void);
+
 #ifdef __cplusplus
 }
 #endif
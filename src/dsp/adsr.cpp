@@ -1,10 +1,11 @@
 #include "adsr.h"
+#include "dsp.h"
 #include <math.h>
 
 using namespace daisysp;
 
 void Adsr::Init(float sample_rate, int blockSize) {
-  sample_rate_ = sample_rate / blockSize;
+  sample_rate_ = static_cast<int>(sample_rate / static_cast<float>(blockSize));
   attackShape_ = -1.f;
   attackTarget_ = 0.0f;
   attackTime_ = -1.f;
@@ -48,10 +49,10 @@ void Adsr::SetAttackTime(float timeInS, float shape) {
     attackShape_ = shape;
     if (timeInS > 0.f) {
       float x = shape;
-      float target = 9.f * powf(x, 10.f) + 0.3f * x + 1.01f;
+      float target = 9.f * fastpowf(x, 10.f) + 0.3f * x + 1.01f;
       attackTarget_ = target;
-      float logTarget = logf(1.f - (1.f / target)); // -1 for decay
-      attackD0_ = 1.f - expf(logTarget / (timeInS * sample_rate_));
+      float logTarget = fastlogf(1.f - (1.f / target)); // -1 for decay
+      attackD0_ = -fastexpm1f(logTarget / (timeInS * sample_rate_));
     } else
       attackD0_ = 1.f; // instant change
   }
@@ -67,8 +68,8 @@ void Adsr::SetTimeConstant(float timeInS, float &time, float &coeff) {
   if (timeInS != time) {
     time = timeInS;
     if (time > 0.f) {
-      const float target = logf(1. / M_E);
-      coeff = 1.f - expf(target / (time * sample_rate_));
+      const float target = -1.f; // log(1 / e)
+      coeff = -fastexpm1f(target / (time * sample_rate_));
     } else
       coeff = 1.f; // instant change
   }
@@ -5,9 +5,9 @@ using namespace daisysp;
 
 void DcBlock::Init(float sample_rate)
 {
-    output_ = 0.0;
-    input_  = 0.0;
-    gain_   = 0.99;
+    output_ = 0.0f;
+    input_  = 0.0f;
+    gain_   = 0.99f;
 }
 
 float DcBlock::Process(float in)
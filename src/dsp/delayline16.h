@@ -0,0 +1,145 @@
+#pragma once
+#ifndef DSY_DELAY16_H
+#define DSY_DELAY16_H
+#include <stdlib.h>
+#include <stdint.h>
+#include "dsp.h"
+namespace daisysp
+{
+/** Compact delay line with 16-bit storage.
+
+Same interface as DelayLine<float, max_size>, but samples are stored as
+int16_t in a ring whose length is max_size rounded up to a power of two,
+so every index wraps with a mask instead of a modulo. Samples are
+quantised over +/-kFullScale; larger values saturate.
+
+declaration example: (1 second)
+
+DelayLine16<48000> del;
+*/
+template <size_t max_size>
+class DelayLine16
+{
+  public:
+    /** Largest magnitude stored without clipping */
+    static constexpr float kFullScale = 2.0f;
+
+    /** Ring length in samples (max_size rounded up to a power of two) */
+    static constexpr size_t kSize = get_next_power2(static_cast<uint32_t>(max_size));
+
+    DelayLine16() {}
+    ~DelayLine16() {}
+    /** initializes the delay line by clearing the values within, and setting delay to 1 sample.
+    */
+    void Init() { Reset(); }
+    /** clears buffer, sets write ptr to 0, and delay to 1 sample.
+    */
+    void Reset()
+    {
+        for(size_t i = 0; i < kSize; i++)
+        {
+            line_[i] = 0;
+        }
+        write_ptr_ = 0;
+        delay_     = 1;
+        frac_      = 0.0f;
+    }
+
+    /** sets the delay time in samples
+    */
+    inline void SetDelay(size_t delay)
+    {
+        frac_  = 0.0f;
+        delay_ = delay < max_size ? delay : max_size - 1;
+    }
+
+    /** sets the delay time in samples
+        The fractional part is used to interpolate the delay line.
+    */
+    inline void SetDelay(float delay)
+    {
+        int32_t int_delay = static_cast<int32_t>(delay);
+        frac_             = delay - static_cast<float>(int_delay);
+        delay_ = static_cast<size_t>(int_delay) < max_size ? int_delay
+                                                           : max_size - 1;
+    }
+
+    /** writes a sample to the delay line, and advances the write ptr
+    */
+    inline void Write(const float sample)
+    {
+        line_[write_ptr_] = ToInt(sample);
+        write_ptr_        = (write_ptr_ - 1) & kMask;
+    }
+
+    /** returns the next sample in the delay line, interpolated if necessary.
+    */
+    inline float Read() const
+    {
+        float a = At(write_ptr_ + delay_);
+        float b = At(write_ptr_ + delay_ + 1);
+        return a + (b - a) * frac_;
+    }
+
+    /** Read from a set location */
+    inline float Read(float delay) const
+    {
+        int32_t delay_integral   = static_cast<int32_t>(delay);
+        float   delay_fractional = delay - static_cast<float>(delay_integral);
+        const float a = At(write_ptr_ + delay_integral);
+        const float b = At(write_ptr_ + delay_integral + 1);
+        return a + (b - a) * delay_fractional;
+    }
+
+    inline float ReadHermite(float delay) const
+    {
+        int32_t delay_integral   = static_cast<int32_t>(delay);
+        float   delay_fractional = delay - static_cast<float>(delay_integral);
+
+        size_t      t     = write_ptr_ + delay_integral;
+        const float xm1   = At(t - 1);
+        const float x0    = At(t);
+        const float x1    = At(t + 1);
+        const float x2    = At(t + 2);
+        const float c     = (x1 - xm1) * 0.5f;
+        const float v     = x0 - x1;
+        const float w     = c + v;
+        const float a     = w + v + (x2 - x0) * 0.5f;
+        const float b_neg = w + a;
+        const float f     = delay_fractional;
+        return (((a * f) - b_neg) * f + c) * f + x0;
+    }
+
+    inline float Allpass(const float sample, size_t delay, const float coefficient)
+    {
+        float read  = At(write_ptr_ + delay);
+        float write = sample + coefficient * read;
+        Write(write);
+        return -write * coefficient + read;
+    }
+
+  private:
+    static constexpr size_t kMask     = kSize - 1;
+    static constexpr float  kToInt    = 32767.0f / kFullScale;
+    static constexpr float  kToFloat  = kFullScale / 32767.0f;
+
+    static inline int16_t ToInt(float sample)
+    {
+        float s = sample * kToInt;
+        s       = s > 32767.0f ? 32767.0f : (s < -32767.0f ? -32767.0f : s);
+        // Round to nearest so quantisation error has no DC offset
+        return static_cast<int16_t>(s + (s >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    inline float At(size_t index) const
+    {
+        return static_cast<float>(line_[index & kMask]) * kToFloat;
+    }
+
+    float   frac_;
+    size_t  write_ptr_;
+    size_t  delay_;
+    int16_t line_[kSize];
+};
+} // namespace daisysp
+#endif
@@ -15,6 +15,7 @@ https://opensource.org/licenses/MIT.
 #include <cstdint>
 #include <random>
 #include <cmath>
+#include <cstring>
 
 /** PIs
 */
@@ -102,31 +103,101 @@ inline float fastmod1f(float x)
     return x - static_cast<int>(x);
 }
 
-/** From http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html
-No approximation, pow10f(x) gives a 90% speed increase over powf(10.f, x)
+/** Fast math kernels
+
+Polynomial replacements for the libm calls on the audio and control paths;
+single precision throughout, no table memory. Maximum errors measured against
+double-precision libm by tools/host/bench_fastmath:
+
+    fastexp2f(x)     relative 2e-7               x in [-126, 126]
+    fastexpf(x)      relative 2e-7 + 5e-8 |x|    (rounding of x / ln 2)
+    fastexpm1f(x)    relative 6e-7               e^x - 1 without the cancellation near 0
+    fastlog2f(x)     absolute 1e-6               x in [2^-10, 2^10], x > 0 beyond
+    fastlogf(x)      absolute 1e-6               as fastlog2f
+    fastpowf(x, y)   relative 1e-7 (1 + |y log2 x|), x >= 0
+    fastsin2pif(x)   absolute 1.5e-6             sin(2 pi x), |x| < 2^31
+    fastsinf(x)      absolute 1.5e-6             |x| <= 10, grows with |x| beyond
+    fasttanhf(x)     relative 6e-7
 */
-inline float pow10f(float f)
+namespace fastmath
+{
+constexpr float kLog2E = 1.44269504f; // 1 / ln(2)
+constexpr float kLn2   = 0.69314718f;
+
+inline float BitsToFloat(uint32_t bits)
 {
-    return expf(2.302585092994046f * f);
+    float f;
+    std::memcpy(&f, &bits, sizeof f);
+    return f;
 }
 
-/* Original code for fastlog2f by Dr. Paul Beckmann from the ARM community forum, adapted from the CMSIS-DSP library
-About 25% performance increase over std::log10f
-*/
-inline float fastlog2f(float f)
-{
-    float frac;
-    int   exp;
-    frac = frexpf(fabsf(f), &exp);
-    f    = 1.23149591368684f;
-    f *= frac;
-    f += -4.11852516267426f;
-    f *= frac;
-    f += 6.02197014179219f;
-    f *= frac;
-    f += -3.13396450166353f;
-    f += exp;
-    return (f);
+inline uint32_t FloatToBits(float f)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof bits);
+    return bits;
+}
+} // namespace fastmath
+
+/** 2^x. Integer part into the exponent bits, fraction by a degree-5
+    polynomial. Clamped to the normal range of float. */
+inline float fastexp2f(float x)
+{
+    x = x < -126.0f ? -126.0f : (x > 126.0f ? 126.0f : x);
+    int32_t xi = static_cast<int32_t>(x);
+    xi -= x < static_cast<float>(xi) ? 1 : 0; // floor
+    const float f = x - static_cast<float>(xi);
+    float       p = 0.0018775744f;
+    p             = p * f + 0.0089893456f;
+    p             = p * f + 0.055826314f;
+    p             = p * f + 0.24015362f;
+    p             = p * f + 0.69315307f;
+    p             = p * f + 0.99999993f;
+    return p * fastmath::BitsToFloat(static_cast<uint32_t>(xi + 127) << 23);
+}
+
+/** e^x */
+inline float fastexpf(float x)
+{
+    return fastexp2f(x * fastmath::kLog2E);
+}
+
+/** e^x - 1, accurate for small |x| (a Taylor series below 1/4) where
+    fastexpf(x) - 1 would cancel */
+inline float fastexpm1f(float x)
+{
+    if(x > -0.25f && x < 0.25f)
+    {
+        float p = 0.0013888889f;
+        p       = p * x + 0.0083333333f;
+        p       = p * x + 0.041666667f;
+        p       = p * x + 0.16666667f;
+        p       = p * x + 0.5f;
+        p       = p * x + 1.0f;
+        return p * x;
+    }
+    return fastexpf(x) - 1.0f;
+}
+
+/** log2(x) for x > 0. The mantissa is centred on 1 (in [sqrt(0.5), sqrt(2)))
+    and log2(1 + u) = u * P(u) with P of degree 6. 0 and denormals give
+    -127 or so rather than -inf. */
+inline float fastlog2f(float x)
+{
+    const uint32_t bits = fastmath::FloatToBits(x);
+    // Offsetting by the mantissa of sqrt(0.5) moves the exponent step to
+    // sqrt(2), so the mantissa below lands in [sqrt(0.5), sqrt(2))
+    const uint32_t shifted = bits - 0x3F3504F3u;
+    const int32_t  e       = static_cast<int32_t>(shifted) >> 23;
+    const float    u       = fastmath::BitsToFloat(bits - (static_cast<uint32_t>(e) << 23)) - 1.0f;
+    float          p       = 0.17615844f;
+    p                      = p * u - 0.27097454f;
+    p                      = p * u + 0.29510097f;
+    p                      = p * u - 0.35918513f;
+    p                      = p * u + 0.48064866f;
+    p                      = p * u - 0.72136769f;
+    p                      = p * u + 1.4426963f;
+    return p * u + static_cast<float>(e);
 }
 
 inline float fastlog10f(float f)
@@ -134,11 +205,65 @@ inline float fastlog10f(float f)
     return fastlog2f(f) * 0.3010299956639812f;
 }
 
+/** ln(x) for x > 0 */
+inline float fastlogf(float x)
+{
+    return fastlog2f(x) * fastmath::kLn2;
+}
+
+/** x^y for x >= 0 (0 for x <= 0). The error grows with |y log2 x|, the
+    size of the result's exponent. */
+inline float fastpowf(float x, float y)
+{
+    return x > 0.0f ? fastexp2f(y * fastlog2f(x)) : 0.0f;
+}
+
+/** sin(2 pi x): x in cycles, |x| < 2^31. Reduced to [-0.25, 0.25] and an odd
+    polynomial of degree 7 */
+inline float fastsin2pif(float x)
+{
+    x -= static_cast<float>(static_cast<int32_t>(x));          // (-1, 1)
+    x = x > 0.5f ? x - 1.0f : (x < -0.5f ? x + 1.0f : x);      // [-0.5, 0.5]
+    x = x > 0.25f ? 0.5f - x : (x < -0.25f ? -0.5f - x : x);   // [-0.25, 0.25]
+    const float x2 = x * x;
+    float       p  = -71.614701f;
+    p              = p * x2 + 81.408665f;
+    p              = p * x2 - 41.339262f;
+    p              = p * x2 + 6.2831806f;
+    return p * x;
+}
+
+/** sin(x), x in radians */
+inline float fastsinf(float x)
+{
+    return fastsin2pif(x * (1.0f / TWOPI_F));
+}
+
+/** tanh(x) = (e^2x - 1) / (e^2x + 1), through fastexpm1f so small
+    arguments keep their precision */
+inline float fasttanhf(float x)
+{
+    if(x > 9.0f)
+        return 1.0f;
+    if(x < -9.0f)
+        return -1.0f;
+    const float t = fastexpm1f(2.0f * x);
+    return t / (t + 2.0f);
+}
+
+/** From http://openaudio.blogspot.com/2017/02/faster-log10-and-pow.html
+pow10f(x) = e^(ln(10) x), now through fastexpf()
+*/
+inline float pow10f(float f)
+{
+    return fastexpf(2.302585092994046f * f);
+}
+
 /** Midi to frequency helper
 */
 inline float mtof(float m)
 {
-    return powf(2, (m - 69.0f) / 12.0f) * 440.0f;
+    return fastexp2f((m - 69.0f) * kOneTwelfth) * 440.0f;
 }
 
 
@@ -182,8 +307,8 @@ fmap(float in, float min, float max, Mapping curve = Mapping::LINEAR)
             return fclamp(min + (in * in) * (max - min), min, max);
         case Mapping::LOG:
         {
-            const float a = 1.f / log10f(max / min);
-            return fclamp(min * powf(10, in / a), min, max);
+            const float a = 1.f / fastlog10f(max / min);
+            return fclamp(min * pow10f(in / a), min, max);
         }
         case Mapping::LINEAR:
         default: return fclamp(min + in * (max - min), min, max);
@@ -51,16 +51,56 @@ static inline float fast_tanh(float x)
     return x * (27.0f + x2) / (27.0f + 9.0f * x2);
 }
 
+//-----------------------------------------------------------
+// Cutoff -> (alpha, Qadjust) table
+//
+// Both coefficients are polynomials in the normalised cutoff
+// wc = 2 * pi * fc / (fs * oversampling), which SetFreq() clamps to
+// 0.425 * fs, so one table in flash serves every sample rate.
+// Linear interpolation over 128 segments stays within ~3e-6 of the
+// polynomials.
+//-----------------------------------------------------------
+namespace
+{
+constexpr uint8_t kTableOversampling = 4;
+constexpr size_t  kCoeffTableSize    = 128;
+constexpr float   kMaxWc             = 0.425f * TWOPI_F / kTableOversampling;
+
+struct CoeffTable
+{
+    float alpha[kCoeffTableSize + 1];
+    float qadjust[kCoeffTableSize + 1];
+};
+
+constexpr CoeffTable MakeCoeffTable()
+{
+    CoeffTable t{};
+    for(size_t i = 0; i <= kCoeffTableSize; i++)
+    {
+        const float wc  = kMaxWc * static_cast<float>(i) / kCoeffTableSize;
+        const float wc2 = wc * wc;
+        t.alpha[i]      = 0.9892f * wc - 0.4324f * wc2 + 0.1381f * wc * wc2
+                     - 0.0202f * wc2 * wc2;
+        // revised hfQ (rvh - feb 14 2021)
+        t.qadjust[i] = 1.006f + 0.0536f * wc - 0.095f * wc2 - 0.05f * wc2 * wc2;
+    }
+    return t;
+}
+
+constexpr CoeffTable kCoeffTable = MakeCoeffTable();
+} // namespace
+
 void LadderFilter::Init(float sample_rate)
 {
-    sample_rate_  = sample_rate;
-    sr_int_recip_ = 1.0f / (sample_rate * kInterpolation);
-    alpha_        = 1.0f;
-    K_            = 1.0f;
-    Fbase_        = 1000.0f;
-    Qadjust_      = 1.0f;
-    oldinput_     = 0.f;
-    mode_         = FilterMode::LP24;
+    sample_rate_         = sample_rate;
+    sr_int_recip_        = 1.0f / (sample_rate * kInterpolation);
+    state_.alpha         = 1.0f;
+    K_                   = 1.0f;
+    Fbase_               = 1000.0f;
+    state_.qadjust       = 1.0f;
+    state_.oldinput      = 0.f;
+    state_.ramp_remaining = 0;
+    mode_                = FilterMode::LP24;
 
     SetPassbandGain(0.5f);
     SetInputDrive(0.5f);
@@ -68,46 +108,283 @@ void LadderFilter::Init(float sample_rate)
     SetRes(0.2f);
 }
 
-float LadderFilter::Process(float in)
+// One input sample through the 4x oversampled ladder. All six poles are
+// always run because the resonance feedback taps the last one; the mode only
+// selects which stage outputs are mixed into the result, resolved at compile
+// time instead of per oversampling step.
+template <LadderFilter::FilterMode Mode>
+inline float
+LadderFilter::Tick(State& s, float in, float drive, float pbg, float k)
 {
-    float input  = in * drive_;
+    if(s.ramp_remaining > 0)
+    {
+        if(--s.ramp_remaining == 0)
+        {
+            s.alpha   = s.alpha_target;
+            s.qadjust = s.qadjust_target;
+        }
+        else
+        {
+            s.alpha += s.alpha_inc;
+            s.qadjust += s.qadjust_inc;
+        }
+    }
+
+    float input  = in * drive;
     float total  = 0.0f;
     float interp = 0.0f;
     for(size_t os = 0; os < kInterpolation; os++)
     {
-        float u = (interp * oldinput_ + (1.0f - interp) * input)
-                  - (z1_[5] - pbg_ * input) * K_ * Qadjust_;
-        u            = fast_tanh(u);
-        float stage1 = LPF(u, 0);
-        float stage2 = LPF(stage1, 1);
-        float stage3 = LPF(stage2, 2);
-        float stage4 = LPF(stage3, 3);
-        float stage5 = LPF(stage4, 4);
-        float stage6 = LPF(stage5, 5);
-        total += weightedSumForCurrentMode(
-                         {input, stage1, stage2, stage3, stage4, stage5, stage6})
-                 * kInterpolationRecip;
+        float u = (interp * s.oldinput + (1.0f - interp) * input)
+                  - (s.z1[5] - pbg * input) * k * s.qadjust;
+        u = fast_tanh(u);
+
+        float stage[7];
+        stage[0] = u;
+        for(int i = 0; i < 6; i++)
+        {
+            //                    (1.0 / 1.3)   (0.3 / 1.3)
+            float ft   = stage[i] * 0.76923077f + 0.23076923f * s.z0[i] - s.z1[i];
+            ft         = ft * s.alpha + s.z1[i];
+            s.z1[i]    = ft;
+            s.z0[i]    = stage[i];
+            stage[i + 1] = ft;
+        }
+
+        // Weighted filter stage mixing to achieve selected response
+        // as described in "Oscillator and Filter Algorithms for Virtual Analog Synthesis"
+        // Välimäki and Huovilainen, Computer Music Journal, vol 60, 2006
+        float out;
+        if constexpr(Mode == FilterMode::LP36)
+            out = stage[6];
+        else if constexpr(Mode == FilterMode::LP24)
+            out = stage[4];
+        else if constexpr(Mode == FilterMode::LP12)
+            out = stage[2];
+        else if constexpr(Mode == FilterMode::BP36)
+            // 36dB/oct bandpass: difference between 3rd and 6th stage
+            out = (stage[3] - stage[6]) * 6.0f; // scale for unity gain
+        else if constexpr(Mode == FilterMode::BP24)
+            out = (stage[2] + stage[4]) * 4.0f - stage[3] * 8.0f;
+        else
+            out = (stage[1] - stage[2]) * 2.0f;
+
+        total += out * kInterpolationRecip;
         interp += kInterpolationRecip;
     }
-    oldinput_ = input;
+    s.oldinput = input;
     return total;
 }
 
-__attribute__((optimize("unroll-loops"))) void
-LadderFilter::ProcessBlock(float* buf, size_t size)
+float LadderFilter::Process(float in)
+{
+    switch(mode_)
+    {
+        case FilterMode::LP36:
+            return Tick<FilterMode::LP36>(state_, in, drive_, pbg_, K_);
+        case FilterMode::LP24:
+            return Tick<FilterMode::LP24>(state_, in, drive_, pbg_, K_);
+        case FilterMode::LP12:
+            return Tick<FilterMode::LP12>(state_, in, drive_, pbg_, K_);
+        case FilterMode::BP36:
+            return Tick<FilterMode::BP36>(state_, in, drive_, pbg_, K_);
+        case FilterMode::BP24:
+            return Tick<FilterMode::BP24>(state_, in, drive_, pbg_, K_);
+        case FilterMode::BP12:
+            return Tick<FilterMode::BP12>(state_, in, drive_, pbg_, K_);
+    }
+    return Tick<FilterMode::LP36>(state_, in, drive_, pbg_, K_);
+}
+
+template <LadderFilter::FilterMode Mode>
+void LadderFilter::ProcessBlockMode(float* buf, size_t size)
 {
+    // Work on a local copy so the state stays in registers across the block
+    State       s     = state_;
+    const float drive = drive_;
+    const float pbg   = pbg_;
+    const float k     = K_;
     for(size_t i = 0; i < size; i++)
     {
-        buf[i] = Process(buf[i]);
+        buf[i] = Tick<Mode>(s, buf[i], drive, pbg, k);
+    }
+    state_ = s;
+}
+
+void LadderFilter::ProcessBlock(float* buf, size_t size)
+{
+    switch(mode_)
+    {
+        case FilterMode::LP36: ProcessBlockMode<FilterMode::LP36>(buf, size); break;
+        case FilterMode::LP24: ProcessBlockMode<FilterMode::LP24>(buf, size); break;
+        case FilterMode::LP12: ProcessBlockMode<FilterMode::LP12>(buf, size); break;
+        case FilterMode::BP36: ProcessBlockMode<FilterMode::BP36>(buf, size); break;
+        case FilterMode::BP24: ProcessBlockMode<FilterMode::BP24>(buf, size); break;
+        case FilterMode::BP12: ProcessBlockMode<FilterMode::BP12>(buf, size); break;
+    }
+}
+
+namespace
+{
+// Output mix of stage outputs 1..6 per mode, matching Tick<Mode>()
+void StageWeights(LadderFilter::FilterMode mode, float (&w)[6])
+{
+    for(float& x : w)
+        x = 0.0f;
+    switch(mode)
+    {
+        case LadderFilter::FilterMode::LP36: w[5] = 1.0f; break;
+        case LadderFilter::FilterMode::LP24: w[3] = 1.0f; break;
+        case LadderFilter::FilterMode::LP12: w[1] = 1.0f; break;
+        case LadderFilter::FilterMode::BP36:
+            w[2] = 6.0f;
+            w[5] = -6.0f;
+            break;
+        case LadderFilter::FilterMode::BP24:
+            w[1] = 4.0f;
+            w[2] = -8.0f;
+            w[3] = 4.0f;
+            break;
+        case LadderFilter::FilterMode::BP12:
+            w[0] = 2.0f;
+            w[1] = -2.0f;
+            break;
+    }
+}
+} // namespace
+
+void LadderFilter::ProcessLanes(LadderFilter* const* filters,
+                                float* const*        bufs,
+                                size_t               lanes,
+                                size_t               size)
+{
+    if(lanes > kMaxLanes)
+        lanes = kMaxLanes;
+
+    // Structure-of-arrays copy of every lane's state: [stage][lane]
+    float    z0[6][kMaxLanes], z1[6][kMaxLanes], w[6][kMaxLanes];
+    float    alpha[kMaxLanes], qadjust[kMaxLanes], oldinput[kMaxLanes];
+    float    alpha_target[kMaxLanes], alpha_inc[kMaxLanes];
+    float    qadjust_target[kMaxLanes], qadjust_inc[kMaxLanes];
+    float    drive[kMaxLanes], pbg[kMaxLanes], k[kMaxLanes];
+    uint32_t ramp[kMaxLanes];
+
+    for(size_t l = 0; l < lanes; l++)
+    {
+        const LadderFilter& f = *filters[l];
+        const State&        s = f.state_;
+        float               lw[6];
+        StageWeights(f.mode_, lw);
+        for(int i = 0; i < 6; i++)
+        {
+            z0[i][l] = s.z0[i];
+            z1[i][l] = s.z1[i];
+            w[i][l]  = lw[i];
+        }
+        alpha[l]          = s.alpha;
+        qadjust[l]        = s.qadjust;
+        oldinput[l]       = s.oldinput;
+        alpha_target[l]   = s.alpha_target;
+        alpha_inc[l]      = s.alpha_inc;
+        qadjust_target[l] = s.qadjust_target;
+        qadjust_inc[l]    = s.qadjust_inc;
+        ramp[l]           = s.ramp_remaining;
+        drive[l]          = f.drive_;
+        pbg[l]            = f.pbg_;
+        k[l]              = f.K_;
+    }
+
+    for(size_t j = 0; j < size; j++)
+    {
+        float input[kMaxLanes], total[kMaxLanes];
+        for(size_t l = 0; l < lanes; l++)
+        {
+            // Same ramp step as Tick(), written without branches
+            const bool     active = ramp[l] > 0;
+            const uint32_t left   = ramp[l] - (active ? 1u : 0u);
+            const bool     done   = active && left == 0;
+            alpha[l]   = done ? alpha_target[l]
+                              : (active ? alpha[l] + alpha_inc[l] : alpha[l]);
+            qadjust[l] = done ? qadjust_target[l]
+                              : (active ? qadjust[l] + qadjust_inc[l]
+                                        : qadjust[l]);
+            ramp[l]    = left;
+
+            input[l] = bufs[l][j] * drive[l];
+            total[l] = 0.0f;
+        }
+
+        float interp = 0.0f;
+        for(size_t os = 0; os < kInterpolation; os++)
+        {
+            for(size_t l = 0; l < lanes; l++)
+            {
+                float u = (interp * oldinput[l] + (1.0f - interp) * input[l])
+                          - (z1[5][l] - pbg[l] * input[l]) * k[l] * qadjust[l];
+                // fast_tanh() with the saturation branches folded into a clamp
+                u        = u > 3.0f ? 3.0f : (u < -3.0f ? -3.0f : u);
+                float u2 = u * u;
+                float st = u * (27.0f + u2) / (27.0f + 9.0f * u2);
+
+                float out = 0.0f;
+                for(int i = 0; i < 6; i++)
+                {
+                    float ft = st * 0.76923077f + 0.23076923f * z0[i][l] - z1[i][l];
+                    ft       = ft * alpha[l] + z1[i][l];
+                    z1[i][l] = ft;
+                    z0[i][l] = st;
+                    st       = ft;
+                    out += w[i][l] * ft;
+                }
+                total[l] += out * kInterpolationRecip;
+            }
+            interp += kInterpolationRecip;
+        }
+
+        for(size_t l = 0; l < lanes; l++)
+        {
+            oldinput[l] = input[l];
+            bufs[l][j]  = total[l];
+        }
+    }
+
+    for(size_t l = 0; l < lanes; l++)
+    {
+        State& s = filters[l]->state_;
+        for(int i = 0; i < 6; i++)
+        {
+            s.z0[i] = z0[i][l];
+            s.z1[i] = z1[i][l];
+        }
+        s.alpha          = alpha[l];
+        s.qadjust        = qadjust[l];
+        s.oldinput       = oldinput[l];
+        s.ramp_remaining = ramp[l];
     }
 }
 
 void LadderFilter::SetFreq(float freq)
 {
-    Fbase_ = freq;
+    Fbase_                = freq;
+    state_.ramp_remaining = 0;
     compute_coeffs(freq);
 }
 
+void LadderFilter::SetFreqRamped(float freq, size_t samples)
+{
+    if(samples <= 1)
+    {
+        SetFreq(freq);
+        return;
+    }
+    Fbase_ = freq;
+    coeffs_for(freq, state_.alpha_target, state_.qadjust_target);
+    const float recip     = 1.0f / static_cast<float>(samples);
+    state_.alpha_inc      = (state_.alpha_target - state_.alpha) * recip;
+    state_.qadjust_inc    = (state_.qadjust_target - state_.qadjust) * recip;
+    state_.ramp_remaining = static_cast<uint32_t>(samples);
+}
+
 void LadderFilter::SetRes(float res)
 {
     // maps resonance = 0->1 to K = 0 -> 4
@@ -136,52 +413,24 @@ void LadderFilter::SetInputDrive(float odrv)
     }
 }
 
-float LadderFilter::LPF(float s, int i)
+void LadderFilter::compute_coeffs(float freq)
 {
-    //             (1.0 / 1.3)   (0.3 / 1.3)
-    float ft = s * 0.76923077f + 0.23076923f * z0_[i] - z1_[i];
-    ft       = ft * alpha_ + z1_[i];
-    z1_[i]   = ft;
-    z0_[i]   = s;
-    return ft;
+    coeffs_for(freq, state_.alpha, state_.qadjust);
 }
 
-void LadderFilter::compute_coeffs(float freq)
+void LadderFilter::coeffs_for(float freq, float& alpha, float& qadjust) const
 {
+    static_assert(kInterpolation == kTableOversampling,
+                  "coefficient table assumes the filter's oversampling factor");
     freq      = daisysp::fclamp(freq, 5.0f, sample_rate_ * 0.425f);
     float wc  = freq * 2.0f * PI_F * sr_int_recip_;
-    float wc2 = wc * wc;
-    alpha_    = 0.9892f * wc - 0.4324f * wc2 + 0.1381f * wc * wc2
-             - 0.0202f * wc2 * wc2;
-    //Qadjust = 1.0029f + 0.0526f * wc - 0.0926 * wc2 + 0.0218* wc * wc2;
-    Qadjust_ = 1.006f + 0.0536f * wc - 0.095f * wc2 - 0.05f * wc2 * wc2;
-    // revised hfQ (rvh - feb 14 2021)
-}
-
-float LadderFilter::weightedSumForCurrentMode(
-    const std::array<float, 7>& stage_outs)
-{
-    // Weighted filter stage mixing to achieve selected response
-    // as described in "Oscillator and Filter Algorithms for Virtual Analog Synthesis"
-    // Välimäki and Huovilainen, Computer Music Journal, vol 60, 2006
-    switch(mode_)
-    {
-        // New 36dB/oct modes
-        case FilterMode::LP36:
-            return stage_outs[6];
-        case FilterMode::BP36:
-            // 36dB/oct bandpass: difference between 3rd and 6th stage
-            // (classic bandpass is difference between two stages, here 3 and 6 for symmetry)
-            return (stage_outs[3] - stage_outs[6]) * 6.0f; // scale for unity gain
-        // Existing modes mapped to 6-stage structure
-        case FilterMode::LP24: return stage_outs[4]; // 4th stage (legacy)
-        case FilterMode::LP12: return stage_outs[2]; // 2nd stage (legacy)
-        case FilterMode::BP24:
-            return (stage_outs[2] + stage_outs[4]) * 4.0f
-                   - stage_outs[3] * 8.0f;
-        case FilterMode::BP12: return (stage_outs[1] - stage_outs[2]) * 2.0f;
-        
-        default:
-            return stage_outs[6]; // fallback: 36dB/oct lowpass
-    }
+    float pos = wc * (kCoeffTableSize / kMaxWc);
+    size_t i  = static_cast<size_t>(pos);
+    if(i >= kCoeffTableSize)
+        i = kCoeffTableSize - 1;
+    const float frac = pos - static_cast<float>(i);
+    alpha = kCoeffTable.alpha[i]
+            + frac * (kCoeffTable.alpha[i + 1] - kCoeffTable.alpha[i]);
+    qadjust = kCoeffTable.qadjust[i]
+              + frac * (kCoeffTable.qadjust[i + 1] - kCoeffTable.qadjust[i]);
 }
@@ -78,9 +78,30 @@ class LadderFilter
     /** Process single sample */
     float Process(float in);
 
-    /** Process mono buffer/block of samples in place */
+    /** Process mono buffer/block of samples in place.
+        Dispatches on the filter mode once per block and keeps the filter
+        state in locals for the duration of the block. */
     void ProcessBlock(float* buf, size_t size);
 
+    /** Maximum number of filters ProcessLanes() advances together */
+    static constexpr size_t kMaxLanes = 8;
+
+    /** Process several independent filters in lockstep.
+        Filter state is gathered into structure-of-arrays form so every
+        operation runs across all lanes in one loop the compiler can
+        vectorise; results match calling ProcessBlock() on each filter
+        (the bandpass output mixes may differ in the last bits).
+        Each filter keeps its own mode, parameters and coefficient ramp.
+        \param filters Filters to advance, one per lane
+        \param bufs Per-lane buffers processed in place
+        \param lanes Number of lanes, at most kMaxLanes
+        \param size Number of samples per lane
+    */
+    static void ProcessLanes(LadderFilter* const* filters,
+                             float* const*        bufs,
+                             size_t               lanes,
+                             size_t               size);
+
     /**
         Sets the cutoff frequency of the filter.
         Units of hz, valid in range 5 - ~nyquist (samp_rate / 2)
@@ -88,6 +109,15 @@ class LadderFilter
     */
     void SetFreq(float freq);
 
+    /**
+        Sets a new cutoff target and ramps the internal coefficients
+        linearly towards it over the next \p samples calls to Process().
+        Used for control-rate cutoff modulation; SetFreq() cancels a ramp.
+        \param freq Target cutoff in Hz, same range as SetFreq()
+        \param samples Ramp length in samples, 0 or 1 applies immediately
+    */
+    void SetFreqRamped(float freq, size_t samples);
+
     /**
         Sets the resonance of the filter.
         Filter will stably self oscillate at higher values.
@@ -122,22 +152,38 @@ class LadderFilter
     static constexpr float   kInterpolationRecip = 1.0f / kInterpolation;
     static constexpr float   kMaxResonance       = 1.8f;
 
+    /** Per-sample filter state, grouped so ProcessBlock() can keep a local
+        copy in registers for the whole block. */
+    struct State
+    {
+        float z0[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        float z1[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        float alpha;
+        float qadjust;
+        float oldinput;
+
+        // Coefficient ramp for SetFreqRamped()
+        float    alpha_target, alpha_inc;
+        float    qadjust_target, qadjust_inc;
+        uint32_t ramp_remaining = 0;
+    };
+
     float      sample_rate_, sr_int_recip_;
-    float      alpha_;
-    float      beta_[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-    float      z0_[6]   = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-    float      z1_[6]   = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    State      state_;
     float      K_;
     float      Fbase_;
-    float      Qadjust_;
     float      pbg_;
     float      drive_, drive_scaled_;
-    float      oldinput_;
     FilterMode mode_;
 
-    float LPF(float s, int i);
-    void  compute_coeffs(float fc);
-    float weightedSumForCurrentMode(const std::array<float, 7>& stage_outs);
+    template <FilterMode Mode>
+    static float Tick(State& s, float in, float drive, float pbg, float k);
+
+    template <FilterMode Mode>
+    void ProcessBlockMode(float* buf, size_t size);
+
+    void compute_coeffs(float fc);
+    void coeffs_for(float fc, float& alpha, float& qadjust) const;
 };
 
 
@@ -9,7 +9,7 @@ float Oscillator::Process()
     float out, t;
     switch(waveform_)
     {
-        case WAVE_SIN: out = sinf(phase_ * TWOPI_F); break;
+        case WAVE_SIN: out = fastsin2pif(phase_); break;
         case WAVE_TRI:
             t   = -1.0f + (2.0f * phase_);
             out = 2.0f * (fabsf(t) - 0.5f);
@@ -0,0 +1,265 @@
+#include "dsp.h"
+#include "oscillator_bank.h"
+
+using namespace daisysp;
+
+namespace
+{
+constexpr float kPhaseScale = 4294967296.0f;       // 2^32, one cycle
+constexpr float kPhaseRecip = 1.0f / kPhaseScale;  // phase counts -> 0..1
+constexpr uint32_t kHalfCycle = 0x80000000u;
+
+/** PolyBLEP residual for a step at phase 0, evaluated at phase \p p.
+    Zero except within one phase increment either side of the step; the
+    signed distance to the step, in increments, is x in (-1, 1) and the
+    residual is -(1 - x)^2 after the step and (1 + x)^2 before it. */
+inline float Blep(uint32_t p, uint32_t phase_inc, float inc_recip)
+{
+    if(static_cast<uint32_t>(p + phase_inc) >= 2u * phase_inc)
+        return 0.0f;
+    const float x = static_cast<float>(static_cast<int32_t>(p)) * inc_recip;
+    const float r = 1.0f - fabsf(x);
+    return x < 0.0f ? r * r : -(r * r);
+}
+} // namespace
+
+void OscillatorBank::Init(float sample_rate, size_t count)
+{
+    sr_       = sample_rate;
+    sr_recip_ = 1.0f / sample_rate;
+    count_    = count < kMaxOscillators ? count : kMaxOscillators;
+    for(size_t i = 0; i < kMaxOscillators; i++)
+    {
+        osc_[i] = Osc();
+        SetFreq(i, 100.0f);
+    }
+}
+
+void OscillatorBank::SetInc(Osc& o, float inc)
+{
+    o.inc       = inc;
+    o.phase_inc = static_cast<uint32_t>(inc * kPhaseScale);
+    o.inc_recip = o.phase_inc ? 1.0f / static_cast<float>(o.phase_inc) : 0.0f;
+}
+
+void OscillatorBank::SetFreq(size_t i, float freq)
+{
+    Osc& o      = osc_[i];
+    o.ramp_left = 0;
+    SetInc(o, fclamp(freq, 0.0f, sr_ * 0.4999f) * sr_recip_);
+}
+
+void OscillatorBank::SetFreqRamped(size_t i, float freq, size_t samples)
+{
+    if(samples <= 1)
+    {
+        SetFreq(i, freq);
+        return;
+    }
+    Osc&        o    = osc_[i];
+    const float to   = fclamp(freq, 0.0f, sr_ * 0.4999f) * sr_recip_;
+    const float step = 1.0f / static_cast<float>(samples);
+
+    // Work out the end point to step the reciprocal towards it; the ramp
+    // start is whatever the increment is now, mid-ramp or not
+    Osc end = o;
+    SetInc(end, to);
+    const int64_t span = static_cast<int64_t>(end.phase_inc) - static_cast<int64_t>(o.phase_inc);
+    o.ramp_inc   = static_cast<int32_t>(span / static_cast<int64_t>(samples));
+    o.ramp_frac  = (end.inc - o.inc) * step;
+    o.ramp_recip = (end.inc_recip - o.inc_recip) * step;
+    o.ramp_left  = static_cast<uint32_t>(samples);
+    o.ramp_to    = to;
+}
+
+void OscillatorBank::StepRamp(Osc& o, size_t samples)
+{
+    o.phase_inc += static_cast<uint32_t>(o.ramp_inc) * static_cast<uint32_t>(samples);
+    o.inc += o.ramp_frac * static_cast<float>(samples);
+    o.inc_recip += o.ramp_recip * static_cast<float>(samples);
+    o.ramp_left -= static_cast<uint32_t>(samples);
+    if(o.ramp_left == 0)
+    {
+        // Land exactly; the integer steps drop the remainder of the span
+        SetInc(o, o.ramp_to);
+    }
+}
+
+void OscillatorBank::SetPw(size_t i, float pw)
+{
+    pw         = fclamp(pw, 0.0f, 1.0f);
+    osc_[i].pw = pw >= 1.0f ? 0xFFFFFFFFu : static_cast<uint32_t>(pw * kPhaseScale);
+}
+
+template <uint8_t Waveform>
+inline float OscillatorBank::Tick(Osc& o)
+{
+    const uint32_t p = o.phase;
+    const float    t = static_cast<float>(p) * kPhaseRecip;
+    float          out;
+    if constexpr(Waveform == Oscillator::WAVE_SIN)
+    {
+        out = fastsin2pif(t);
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_TRI)
+    {
+        out = 2.0f * (fabsf(2.0f * t - 1.0f) - 0.5f);
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_SAW)
+    {
+        out = 1.0f - 2.0f * t;
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_RAMP)
+    {
+        out = 2.0f * t - 1.0f;
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_SQUARE)
+    {
+        out = p < o.pw ? 1.0f : -1.0f;
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_POLYBLEP_TRI)
+    {
+        out = p < kHalfCycle ? 1.0f : -1.0f;
+        out += Blep(p, o.phase_inc, o.inc_recip);
+        out -= Blep(p + kHalfCycle, o.phase_inc, o.inc_recip);
+        // Leaky integrator turns the bandlimited square into a triangle
+        out        = o.inc * out + (1.0f - o.inc) * o.last_out;
+        o.last_out = out;
+        out *= 4.0f;
+    }
+    else if constexpr(Waveform == Oscillator::WAVE_POLYBLEP_SAW)
+    {
+        out = 1.0f - 2.0f * t + Blep(p, o.phase_inc, o.inc_recip);
+    }
+    else // WAVE_POLYBLEP_SQUARE
+    {
+        out = p < o.pw ? 1.0f : -1.0f;
+        out += Blep(p, o.phase_inc, o.inc_recip);
+        out -= Blep(p - o.pw, o.phase_inc, o.inc_recip);
+        out *= 0.707f;
+    }
+    o.phase = p + o.phase_inc; // wraps modulo one cycle
+    return out * o.amp;
+}
+
+template <uint8_t Waveform, typename Op>
+void OscillatorBank::RenderWaveform(Osc& o, float* out, size_t size)
+{
+    Osc    local = o;
+    size_t j     = 0;
+    if(local.ramp_left > 0)
+    {
+        const size_t ramp = size < local.ramp_left ? size : local.ramp_left;
+        for(; j < ramp; j++)
+        {
+            out[j] = Op::Apply(out[j], Tick<Waveform>(local));
+            local.phase_inc += static_cast<uint32_t>(local.ramp_inc);
+            local.inc += local.ramp_frac;
+            local.inc_recip += local.ramp_recip;
+        }
+        // Steps already taken; this only counts them off and lands
+        local.ramp_left -= static_cast<uint32_t>(ramp);
+        if(local.ramp_left == 0)
+            SetInc(local, local.ramp_to);
+    }
+    for(; j < size; j++)
+        out[j] = Op::Apply(out[j], Tick<Waveform>(local));
+    o = local;
+}
+
+template <typename Op>
+void OscillatorBank::Render(size_t i, float* out, size_t size)
+{
+    Osc& o = osc_[i];
+    switch(o.waveform)
+    {
+        case Oscillator::WAVE_SIN:
+            RenderWaveform<Oscillator::WAVE_SIN, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_TRI:
+            RenderWaveform<Oscillator::WAVE_TRI, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_SAW:
+            RenderWaveform<Oscillator::WAVE_SAW, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_RAMP:
+            RenderWaveform<Oscillator::WAVE_RAMP, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_SQUARE:
+            RenderWaveform<Oscillator::WAVE_SQUARE, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_POLYBLEP_TRI:
+            RenderWaveform<Oscillator::WAVE_POLYBLEP_TRI, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_POLYBLEP_SAW:
+            RenderWaveform<Oscillator::WAVE_POLYBLEP_SAW, Op>(o, out, size);
+            break;
+        case Oscillator::WAVE_POLYBLEP_SQUARE:
+            RenderWaveform<Oscillator::WAVE_POLYBLEP_SQUARE, Op>(o, out, size);
+            break;
+    }
+}
+
+float OscillatorBank::Process(size_t i)
+{
+    Osc&  o = osc_[i];
+    float out;
+    switch(o.waveform)
+    {
+        case Oscillator::WAVE_SIN: out = Tick<Oscillator::WAVE_SIN>(o); break;
+        case Oscillator::WAVE_TRI: out = Tick<Oscillator::WAVE_TRI>(o); break;
+        case Oscillator::WAVE_SAW: out = Tick<Oscillator::WAVE_SAW>(o); break;
+        case Oscillator::WAVE_RAMP: out = Tick<Oscillator::WAVE_RAMP>(o); break;
+        case Oscillator::WAVE_SQUARE:
+            out = Tick<Oscillator::WAVE_SQUARE>(o);
+            break;
+        case Oscillator::WAVE_POLYBLEP_TRI:
+            out = Tick<Oscillator::WAVE_POLYBLEP_TRI>(o);
+            break;
+        case Oscillator::WAVE_POLYBLEP_SAW:
+            out = Tick<Oscillator::WAVE_POLYBLEP_SAW>(o);
+            break;
+        case Oscillator::WAVE_POLYBLEP_SQUARE:
+            out = Tick<Oscillator::WAVE_POLYBLEP_SQUARE>(o);
+            break;
+        default: return 0.0f;
+    }
+    if(o.ramp_left > 0)
+        StepRamp(o, 1);
+    return out;
+}
+
+void OscillatorBank::ProcessAdd(size_t i, float* out, size_t size)
+{
+    Render<Add>(i, out, size);
+}
+
+void OscillatorBank::ProcessMul(size_t i, float* out, size_t size)
+{
+    Render<Mul>(i, out, size);
+}
+
+void OscillatorBank::Advance(size_t samples)
+{
+    for(size_t i = 0; i < count_; i++)
+    {
+        Osc& o = osc_[i];
+        if(o.ramp_left > 0)
+        {
+            // Cover the ramped part at its mean increment
+            const size_t   ramp  = samples < o.ramp_left ? samples : o.ramp_left;
+            const uint32_t start = o.phase_inc;
+            StepRamp(o, ramp);
+            o.phase += static_cast<uint32_t>((static_cast<uint64_t>(start) + o.phase_inc) / 2 * ramp);
+            samples -= ramp;
+        }
+        o.phase += o.phase_inc * static_cast<uint32_t>(samples);
+        if(o.waveform == Oscillator::WAVE_POLYBLEP_TRI)
+        {
+            // Settled integrator output at the new phase: a +/-0.25 triangle
+            // rising from the start of the cycle
+            const float t = static_cast<float>(o.phase) * kPhaseRecip;
+            o.last_out    = 0.25f * (1.0f - 2.0f * fabsf(2.0f * t - 1.0f));
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+#ifndef DSY_OSCILLATOR_BANK_H
+#define DSY_OSCILLATOR_BANK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "oscillator.h"
+
+#ifdef __cplusplus
+
+namespace daisysp
+{
+/**
+ * The up-to-three oscillators of a synth voice, rendered a block at a time.
+ *
+ * Produces the same waveforms as Oscillator (the Oscillator::WAVE_* values
+ * select them) with a different inner structure:
+ * - 32-bit integer phase accumulators that wrap for free on overflow,
+ * - one loop per waveform, selected once per block instead of per sample,
+ * - PolyBLEP correction computed only in the samples next to a discontinuity,
+ * - no end-of-cycle/end-of-rise bookkeeping.
+ */
+class OscillatorBank
+{
+  public:
+    static constexpr size_t kMaxOscillators = 3;
+
+    OscillatorBank()  = default;
+    ~OscillatorBank() = default;
+
+    /** Initializes the bank with \p count oscillators (at most kMaxOscillators).
+        Each starts like Oscillator::Init(): 100 Hz, amplitude 0.5, pulse
+        width 0.5, sine wave, phase 0.
+    */
+    void Init(float sample_rate, size_t count);
+
+    /** Number of active oscillators */
+    inline size_t Count() const { return count_; }
+
+    /** Sets the frequency of oscillator \p i in Hz, clamped to just below sample_rate / 2.
+        Cancels a ramp started by SetFreqRamped(). */
+    void SetFreq(size_t i, float freq);
+
+    /** Moves the frequency of oscillator \p i to \p freq over the next
+        \p samples samples: the phase increment steps linearly once per
+        sample and lands exactly on \p freq. For glides updated at control
+        rate; \p samples of 0 or 1 is the same as SetFreq().
+    */
+    void SetFreqRamped(size_t i, float freq, size_t samples);
+
+    /** Sets the amplitude of oscillator \p i */
+    inline void SetAmp(size_t i, float amp) { osc_[i].amp = amp; }
+
+    /** Sets the waveform of oscillator \p i, one of Oscillator::WAVE_* */
+    inline void SetWaveform(size_t i, uint8_t wf)
+    {
+        osc_[i].waveform = wf < Oscillator::WAVE_LAST ? wf : Oscillator::WAVE_SIN;
+    }
+
+    /** Sets the pulse width of oscillator \p i for the square waveforms (0 - 1) */
+    void SetPw(size_t i, float pw);
+
+    /** Renders one sample of oscillator \p i. For per-sample callers and for
+        oscillators whose frequency changes every sample. */
+    float Process(size_t i);
+
+    /** Adds \p size samples of oscillator \p i to \p out */
+    void ProcessAdd(size_t i, float* out, size_t size);
+
+    /** Multiplies \p size samples of oscillator \p i into \p out (ring modulation) */
+    void ProcessMul(size_t i, float* out, size_t size);
+
+    /** Advances every oscillator's phase by \p samples without rendering,
+        so a silent voice keeps its phase relationships. The triangle's
+        integrator is set to its settled value for the new phase. */
+    void Advance(size_t samples);
+
+  private:
+    struct Osc
+    {
+        uint32_t phase     = 0;
+        uint32_t phase_inc = 0;
+        uint32_t pw        = 0x80000000u;
+        float    inc       = 0.0f; // phase increment as a fraction of a cycle
+        float    inc_recip = 0.0f; // 1 / phase_inc, scales PolyBLEP positions
+        float    amp       = 0.5f;
+        float    last_out  = 0.0f;
+        uint8_t  waveform  = Oscillator::WAVE_SIN;
+
+        // SetFreqRamped(): per-sample steps of the three increment fields,
+        // samples left and the value inc lands on
+        int32_t  ramp_inc   = 0;
+        float    ramp_frac  = 0.0f;
+        float    ramp_recip = 0.0f;
+        uint32_t ramp_left  = 0;
+        float    ramp_to    = 0.0f;
+    };
+
+    struct Add
+    {
+        static float Apply(float acc, float s) { return acc + s; }
+    };
+    struct Mul
+    {
+        static float Apply(float acc, float s) { return acc * s; }
+    };
+
+    template <uint8_t Waveform>
+    static float Tick(Osc& o);
+
+    /** Sets the increment fields of \p o from \p inc (cycles per sample) */
+    static void SetInc(Osc& o, float inc);
+
+    /** Takes \p samples steps (at most o.ramp_left) of the ramp in \p o */
+    static void StepRamp(Osc& o, size_t samples);
+
+    template <typename Op>
+    void Render(size_t i, float* out, size_t size);
+
+    template <uint8_t Waveform, typename Op>
+    static void RenderWaveform(Osc& o, float* out, size_t size);
+
+    float  sr_, sr_recip_;
+    Osc    osc_[kMaxOscillators];
+    size_t count_ = 0;
+};
+
+} // namespace daisysp
+#endif
+#endif
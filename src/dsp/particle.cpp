@@ -8,26 +8,31 @@ void Particle::Init(float sample_rate)
 {
     sample_rate_ = sample_rate;
 
-    sync_ = false;
-    aux_  = 0.f;
+    sync_         = false;
+    aux_          = 0.f;
+    frequency_    = 0.f;
+    grains_valid_ = 0;
     SetFreq(440.f);
     resonance_ = .9f;
     density_   = .5f;
+    density_root_ = sqrtf(density_);
     gain_      = 1.f;
     spread_    = 1.f;
 
     SetRandomFreq(sample_rate_ / 48.f); //48 is the default block size
     rand_phase_ = 0.f;
+    SetSeed(0);
 
     pre_gain_ = 0.0f;
     filter_.Init(sample_rate_);
     filter_.SetDrive(.7f);
+    filter_.SetRes(resonance_);
 }
 
 float Particle::Process()
 {
-    float u = rand() * kRandFrac;
-    float s = 0.0f;
+    const float u = (NextRandom() >> 8) * kUnitFrac;
+    float       s = 0.0f;
 
     if(u <= density_ || sync_)
     {
@@ -38,18 +43,29 @@ float Particle::Process()
         {
             rand_phase_ = rand_phase_ >= 1.f ? rand_phase_ - 1.f : rand_phase_;
 
-            const float u = 2.0f * rand() * kRandFrac - 1.0f;
-            const float f
-                = fmin(powf(2.f, kRatioFrac * spread_ * u) * frequency_, .25f);
-            pre_gain_ = 0.5f / sqrtf(resonance_ * f * sqrtf(density_));
-            filter_.SetFreq(f * sample_rate_);
-            filter_.SetRes(resonance_);
+            const Grain& grain = GrainAt(NextRandom() >> (32 - kGrainBits));
+            pre_gain_          = grain.gain / sqrtf(density_root_);
+            filter_.SetCoefficients(grain.coeffs);
         }
     }
     aux_ = s;
 
-    filter_.Process(pre_gain_ * s);
-    return filter_.Band();
+    return filter_.Process<Svf::Output::Band>(pre_gain_ * s);
+}
+
+const Particle::Grain& Particle::GrainAt(uint32_t index)
+{
+    Grain& grain = grains_[index];
+    if(!(grains_valid_ >> index & 1u))
+    {
+        const float u = 2.0f * index / (kGrainCount - 1) - 1.0f;
+        const float f
+            = fminf(fastexp2f(kRatioFrac * spread_ * u) * frequency_, .25f);
+        grain.coeffs = filter_.CoefficientsFor(f * sample_rate_);
+        grain.gain   = 0.5f / sqrtf(resonance_ * f);
+        grains_valid_ |= uint64_t{1} << index;
+    }
+    return grain;
 }
 
 float Particle::GetNoise()
@@ -60,12 +76,23 @@ float Particle::GetNoise()
 void Particle::SetFreq(float freq)
 {
     freq /= sample_rate_;
-    frequency_ = fclamp(freq, 0.f, 1.f);
+    freq = fclamp(freq, 0.f, 1.f);
+    if(freq != frequency_)
+    {
+        frequency_    = freq;
+        grains_valid_ = 0;
+    }
 }
 
 void Particle::SetResonance(float resonance)
 {
-    resonance_ = fclamp(resonance, 0.f, 1.f);
+    resonance = fclamp(resonance, 0.f, 1.f);
+    if(resonance != resonance_)
+    {
+        resonance_ = resonance;
+        filter_.SetRes(resonance_);
+        grains_valid_ = 0;
+    }
 }
 
 void Particle::SetRandomFreq(float freq)
@@ -76,7 +103,8 @@ void Particle::SetRandomFreq(float freq)
 
 void Particle::SetDensity(float density)
 {
-    density_ = fclamp(density * .3f, 0.f, 1.f);
+    density_      = fclamp(density * .3f, 0.f, 1.f);
+    density_root_ = sqrtf(density_);
 }
 
 void Particle::SetGain(float gain)
@@ -86,10 +114,26 @@ void Particle::SetGain(float gain)
 
 void Particle::SetSpread(float spread)
 {
-    spread_ = spread < 0.f ? 0.f : spread;
+    spread = spread < 0.f ? 0.f : spread;
+    if(spread != spread_)
+    {
+        spread_       = spread;
+        grains_valid_ = 0;
+    }
 }
 
 void Particle::SetSync(bool sync)
 {
     sync_ = sync;
-}
\ No newline at end of file
+}
+
+void Particle::SetSeed(uint32_t seed)
+{
+    // Scramble so neighbouring seeds (voice ids) start far apart in the
+    // sequence; xorshift must not start at 0
+    uint32_t s = (seed + 1u) * 0x9E3779B9u;
+    s ^= s >> 16;
+    s *= 0x85EBCA6Bu;
+    s ^= s >> 13;
+    rng_ = s != 0 ? s : 1u;
+}
@@ -4,7 +4,6 @@
 
 #include "svf.h"
 #include <stdint.h>
-#include <cstdlib>
 #ifdef __cplusplus
 
 /** @file particle.h */
@@ -72,20 +71,57 @@ class Particle
     */
     void SetSync(bool sync);
 
+    /** Seed the grain generator. Each instance has its own, so voices
+        given different seeds (e.g. their id) play different grains and a
+        render is reproducible.
+        \param seed Any value
+    */
+    void SetSeed(uint32_t seed);
+
   private:
-    static constexpr float kRandFrac  = 1.f / (float)RAND_MAX;
     static constexpr float kRatioFrac = 1.f / 12.f;
-    float                  sample_rate_;
+    // 2^-24: a 24-bit random integer to [0, 1)
+    static constexpr float kUnitFrac = 1.f / 16777216.f;
+
+    // The spread is drawn from kGrainCount evenly spaced ratios in
+    // [2^(-spread/12), 2^(spread/12)]; each one's filter coefficients and
+    // gain are computed on first use and kept until the centre frequency,
+    // spread or resonance change
+    static constexpr uint32_t kGrainBits  = 6;
+    static constexpr uint32_t kGrainCount = 1u << kGrainBits;
+    static_assert(kGrainCount <= 64, "grains_valid_ holds one bit per grain");
+    struct Grain
+    {
+        Svf::Coefficients coeffs;
+        float             gain; // 0.5 / sqrt(resonance * f)
+    };
+
+    float sample_rate_;
     float aux_, frequency_, density_, gain_, spread_, resonance_;
+    float density_root_; // sqrtf(density_), for the grain gain
     bool  sync_;
 
 
     float rand_phase_;
     float rand_freq_;
+    uint32_t rng_; // xorshift32 state, never 0
+
+
+    float    pre_gain_;
+    Svf      filter_;
+    Grain    grains_[kGrainCount];
+    uint64_t grains_valid_; // bit i set when grains_[i] is up to date
 
+    /** Next xorshift32 value */
+    inline uint32_t NextRandom()
+    {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        return rng_;
+    }
 
-    float pre_gain_;
-    Svf   filter_;
+    const Grain& GrainAt(uint32_t index);
 };
 } // namespace daisysp
 #endif
@@ -55,17 +55,148 @@ void Svf::Process(float in)
     out_notch_ += 0.5f * notch_;
 }
 
+template <Svf::Output Out>
+inline float
+Svf::Pass(float in, float& low, float& band, float freq, float damp, float drive)
+{
+    const float notch = in - damp * band;
+    low               = low + freq * band;
+    const float high  = notch - low;
+    band              = freq * high + band - drive * band * band * band;
+    if constexpr(Out == Output::Low)
+        return low;
+    else if constexpr(Out == Output::High)
+        return high;
+    else if constexpr(Out == Output::Band)
+        return band;
+    else if constexpr(Out == Output::Notch)
+        return notch;
+    else
+        return low - high;
+}
+
+// Only the requested output member is written, so its accessor stays valid
+// after Process<Out>() and ProcessBlock<Out>()
+template <Svf::Output Out>
+inline void Svf::Store(float value)
+{
+    if constexpr(Out == Output::Low)
+        out_low_ = value;
+    else if constexpr(Out == Output::High)
+        out_high_ = value;
+    else if constexpr(Out == Output::Band)
+        out_band_ = value;
+    else if constexpr(Out == Output::Notch)
+        out_notch_ = value;
+    else
+        out_peak_ = value;
+}
+
+template <Svf::Output Out>
+float Svf::Process(float in)
+{
+    float low  = low_;
+    float band = band_;
+    // Same operations in the same order as Process(): 0.5 * first pass,
+    // then += 0.5 * second pass
+    float out = 0.5f * Pass<Out>(in, low, band, freq_, damp_, drive_);
+    out += 0.5f * Pass<Out>(in, low, band, freq_, damp_, drive_);
+    low_  = low;
+    band_ = band;
+    Store<Out>(out);
+    return out;
+}
+
+template <Svf::Output Out>
+void Svf::ProcessBlock(float* buf, size_t size)
+{
+    if(size == 0)
+        return;
+    float       low   = low_;
+    float       band  = band_;
+    const float freq  = freq_;
+    const float damp  = damp_;
+    const float drive = drive_;
+    for(size_t i = 0; i < size; i++)
+    {
+        const float in  = buf[i];
+        float       out = 0.5f * Pass<Out>(in, low, band, freq, damp, drive);
+        out += 0.5f * Pass<Out>(in, low, band, freq, damp, drive);
+        buf[i] = out;
+    }
+    low_  = low;
+    band_ = band;
+    Store<Out>(buf[size - 1]);
+}
+
+template float Svf::Process<Svf::Output::Low>(float);
+template float Svf::Process<Svf::Output::High>(float);
+template float Svf::Process<Svf::Output::Band>(float);
+template float Svf::Process<Svf::Output::Notch>(float);
+template float Svf::Process<Svf::Output::Peak>(float);
+template void  Svf::ProcessBlock<Svf::Output::Low>(float*, size_t);
+template void  Svf::ProcessBlock<Svf::Output::High>(float*, size_t);
+template void  Svf::ProcessBlock<Svf::Output::Band>(float*, size_t);
+template void  Svf::ProcessBlock<Svf::Output::Notch>(float*, size_t);
+template void  Svf::ProcessBlock<Svf::Output::Peak>(float*, size_t);
+
+void Svf::ProcessHighLanes(Svf* const* filters, float* const* bufs, size_t lanes, size_t size)
+{
+    if(lanes > kMaxLanes)
+        lanes = kMaxLanes;
+
+    float low[kMaxLanes], band[kMaxLanes], damp[kMaxLanes], freq[kMaxLanes],
+        drive[kMaxLanes];
+    for(size_t l = 0; l < lanes; l++)
+    {
+        low[l]   = filters[l]->low_;
+        band[l]  = filters[l]->band_;
+        damp[l]  = filters[l]->damp_;
+        freq[l]  = filters[l]->freq_;
+        drive[l] = filters[l]->drive_;
+    }
+
+    for(size_t j = 0; j < size; j++)
+    {
+        for(size_t l = 0; l < lanes; l++)
+        {
+            const float in = bufs[l][j];
+            float       out_high
+                = 0.5f
+                  * Pass<Output::High>(in, low[l], band[l], freq[l], damp[l], drive[l]);
+            out_high += 0.5f
+                        * Pass<Output::High>(
+                            in, low[l], band[l], freq[l], damp[l], drive[l]);
+            bufs[l][j] = out_high;
+        }
+    }
+
+    for(size_t l = 0; l < lanes && size > 0; l++)
+    {
+        Svf& f      = *filters[l];
+        f.low_      = low[l];
+        f.band_     = band[l];
+        f.out_high_ = bufs[l][size - 1];
+    }
+}
+
 void Svf::SetFreq(float f)
 {
-    fc_ = fclamp(f, 1.0e-6, fc_max_);
-    // Set Internal Frequency for fc_
-    freq_ = 2.0f
-            * sinf(PI_F
-                   * MIN(0.25f,
-                         fc_ / (sr_ * 2.0f))); // fs*2 because double sampled
-    // recalculate damp
-    damp_ = MIN(2.0f * (1.0f - powf(res_, 0.25f)),
-                MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
+    fc_ = fclamp(f, 1.0e-6f, fc_max_);
+    SetCoefficients(CoefficientsFor(fc_));
+}
+
+Svf::Coefficients Svf::CoefficientsFor(float f) const
+{
+    const float fc = fclamp(f, 1.0e-6f, fc_max_);
+    Coefficients c;
+    // Set Internal Frequency for fc: 2 sin(pi * fc / (2 fs)), fs*2 because
+    // double sampled
+    c.freq = 2.0f * fastsin2pif(0.5f * MIN(0.25f, fc / (sr_ * 2.0f)));
+    // recalculate damp; res^0.25 as two square roots (VSQRT on the M33)
+    c.damp = MIN(2.0f * (1.0f - sqrtf(sqrtf(res_))),
+                 MIN(2.0f, 2.0f / c.freq - c.freq * 0.5f));
+    return c;
 }
 
 void Svf::SetRes(float r)
@@ -73,7 +204,7 @@ void Svf::SetRes(float r)
     float res = fclamp(r, 0.f, 1.f);
     res_      = res;
     // recalculate damp
-    damp_  = MIN(2.0f * (1.0f - powf(res_, 0.25f)),
+    damp_  = MIN(2.0f * (1.0f - sqrtf(sqrtf(res_))),
                 MIN(2.0f, 2.0f / freq_ - freq_ * 0.5f));
     drive_ = pre_drive_ * res_;
 }
@@ -10,6 +10,8 @@ https://opensource.org/licenses/MIT.
 #ifndef DSY_SVF_H
 #define DSY_SVF_H
 
+#include <stddef.h>
+
 namespace daisysp
 {
 /**      Double Sampled, Stable State Variable Filter
@@ -39,12 +41,74 @@ class Svf
     */
     void Process(float in);
 
+    /** Responses Process<Out>() and ProcessBlock<Out>() can compute */
+    enum class Output
+    {
+        Low,
+        High,
+        Band,
+        Notch,
+        Peak
+    };
+
+    /** Process the input signal, computing only one response.
+        The filter state advances exactly as in Process(), and the returned
+        sample is bit-identical to what the matching accessor would give after
+        it. Only that accessor is updated; the other outputs keep stale values.
+        \param in Input sample
+        \return The requested output
+    */
+    template <Output Out>
+    float Process(float in);
+
+    /** Process a buffer in place, replacing each sample by one response.
+        Same samples as calling Process<Out>() on each, with the state kept in
+        locals for the whole block.
+        \param buf Buffer processed in place
+        \param size Number of samples
+    */
+    template <Output Out>
+    void ProcessBlock(float* buf, size_t size);
+
+    /** Maximum number of filters ProcessHighLanes() advances together */
+    static constexpr size_t kMaxLanes = 8;
+
+    /** Process several independent filters in lockstep, high-pass output only.
+        Each lane's buffer is replaced by the High() output sample by sample,
+        with the state kept in structure-of-arrays form so the compiler can
+        vectorise across lanes. Afterwards only High() is up to date.
+        \param filters Filters to advance, one per lane
+        \param bufs Per-lane buffers processed in place
+        \param lanes Number of lanes, at most kMaxLanes
+        \param size Number of samples per lane
+    */
+    static void ProcessHighLanes(Svf* const* filters, float* const* bufs, size_t lanes, size_t size);
+
 
     /** sets the frequency of the cutoff frequency. 
         f must be between 0.0 and sample_rate / 3
     */
     void SetFreq(float f);
 
+    /** Frequency and damping for one cutoff, so a caller that keeps
+        switching between a few cutoffs can compute them once */
+    struct Coefficients
+    {
+        float freq, damp;
+    };
+
+    /** Coefficients SetFreq(f) would set, at the current resonance */
+    Coefficients CoefficientsFor(float f) const;
+
+    /** Switches to coefficients from CoefficientsFor(). The resonance and
+        drive stay as they are.
+    */
+    inline void SetCoefficients(const Coefficients& c)
+    {
+        freq_ = c.freq;
+        damp_ = c.damp;
+    }
+
     /** sets the resonance of the filter.
         Must be between 0.0 and 1.0 to ensure stability.
     */
@@ -81,6 +145,14 @@ class Svf
     float input_;
     float out_low_, out_high_, out_band_, out_peak_, out_notch_;
     float pre_drive_, fc_max_;
+
+    /** One of the two passes per sample on local state; returns the pass's
+        value of the response Out */
+    template <Output Out>
+    static float Pass(float in, float& low, float& band, float freq, float damp, float drive);
+
+    template <Output Out>
+    void Store(float value);
 };
 } // namespace daisysp
 
@@ -77,5 +77,5 @@ void VosimOscillator::SetShape(float shape)
 
 float VosimOscillator::Sine(float phase)
 {
-    return sinf(TWOPI_F * phase);
+    return fastsin2pif(phase);
 }
\ No newline at end of file
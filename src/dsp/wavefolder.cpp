@@ -1,5 +1,5 @@
 #include "wavefolder.h"
-#include <math.h>
+#include <stdint.h>
 
 using namespace daisysp;
 
@@ -11,10 +11,12 @@ void Wavefolder::Init()
 
 float Wavefolder::Process(float in)
 {
-    float ft, sgn;
     in += offset_;
     in *= gain_;
-    ft  = floorf((in + 1.0f) * 0.5f);
-    sgn = static_cast<int>(ft) % 2 == 0 ? 1.0f : -1.0f;
-    return sgn * (in - 2.0f * ft);
+    // Fold index floor((in + 1) / 2); odd folds are mirrored
+    const float x  = (in + 1.0f) * 0.5f;
+    int32_t     ft = static_cast<int32_t>(x);
+    ft -= x < static_cast<float>(ft) ? 1 : 0;
+    const float sgn = (ft & 1) ? -1.0f : 1.0f;
+    return sgn * (in - 2.0f * static_cast<float>(ft));
 }
\ No newline at end of file
@@ -9,6 +9,7 @@ https://opensource.org/licenses/MIT.
 #pragma once
 #ifndef DSY_WHITENOISE_H
 #define DSY_WHITENOISE_H
+#include <stddef.h>
 #include <stdint.h>
 #ifdef __cplusplus
 namespace daisysp
@@ -41,6 +42,20 @@ class WhiteNoise
         return (randseed_ * coeff_) * amp_;
     }
 
+    /** advances the generator as if Process() had been called \p samples times */
+    inline void Advance(size_t samples)
+    {
+        // randseed_ * 16807^samples (mod 2^32), by square-and-multiply
+        uint32_t mult = 1, base = 16807;
+        for(; samples > 0; samples >>= 1)
+        {
+            if(samples & 1)
+                mult *= base;
+            base *= base;
+        }
+        randseed_ = static_cast<int32_t>(static_cast<uint32_t>(randseed_) * mult);
+    }
+
     /** sets the seed (and corrects a seed of 0 to 1) */
     inline void SetSeed(int32_t s) { randseed_ = s == 0 ? 1 : s; }
 
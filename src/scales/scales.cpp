@@ -1,4 +1,5 @@
 #include "scales.h"
+#include <utility> // std::index_sequence
 
  // Scale names array
  const char* scaleNames[SCALES_COUNT] = {
@@ -18,7 +19,7 @@
 };
 
  // Scale intervals array
- int scale[SCALES_COUNT][SCALE_STEPS] = {
+ constexpr uint8_t scale[SCALES_COUNT][SCALE_STEPS] = {
     // Ionian (Major): 1-2-3-4-5-6-7
     {0, 2, 4, 5, 7, 9, 11, 12, 14, 16, 17, 19, 21, 23, 24, 26,
      28, 29, 31, 33, 35, 36, 38, 40, 41, 43, 45, 47, 48, 50, 52, 53,
@@ -85,4 +86,41 @@
      32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47}
 };
 
+namespace
+{
+// Degree tables count a new degree wherever the semitone changes, which
+// matches a walk across distinct semitones only if every row ascends
+constexpr bool rowsAscend()
+{
+    for (size_t s = 0; s < SCALES_COUNT; ++s)
+        for (size_t i = 1; i < SCALE_STEPS; ++i)
+            if (scale[s][i] < scale[s][i - 1])
+                return false;
+    return true;
+}
+static_assert(rowsAscend(), "scale rows must not descend");
+
+constexpr ScaleDegrees makeDegrees(const uint8_t (&row)[SCALE_STEPS])
+{
+    ScaleDegrees t{};
+    t.semitone[0] = row[0];
+    t.count = 1;
+    for (size_t i = 1; i < SCALE_STEPS; ++i)
+    {
+        if (row[i] != row[i - 1])
+            t.semitone[t.count++] = row[i];
+        t.degree[i] = t.count - 1;
+    }
+    return t;
+}
+
+template <size_t... S> constexpr std::array<ScaleDegrees, SCALES_COUNT> makeAllDegrees(std::index_sequence<S...>)
+{
+    return {{makeDegrees(scale[S])...}};
+}
+} // namespace
+
+constexpr std::array<ScaleDegrees, SCALES_COUNT> scaleDegrees =
+    makeAllDegrees(std::make_index_sequence<SCALES_COUNT>{});
+
 extern uint8_t currentScale;
\ No newline at end of file
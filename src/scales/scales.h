@@ -2,6 +2,7 @@
 #define SCALES_H
 
 #include <Arduino.h>
+#include <array>
 
 // Centralized scale size constants — use these everywhere instead of hard-coded literals.
 // This makes it safe to change the number of scales or the number of steps per scale.
@@ -13,8 +14,29 @@ constexpr size_t SCALE_STEPS  = 48;   // Number of step-to-semitone entries per
 //       Instead, inject references via setters (e.g., Voice::setScaleTable and
 //       Voice::setCurrentScalePointer) to keep modules testable and decoupled.
 //       These globals remain for UI/Sequencer modules that manage scale selection.
-extern int scale[SCALES_COUNT][SCALE_STEPS];          // Scale tables: dynamic dimensions
+extern const uint8_t scale[SCALES_COUNT][SCALE_STEPS]; // Scale tables (const, stays in flash)
 extern const char* scaleNames[SCALES_COUNT];          // Human-readable scale names
 extern uint8_t currentScale;      // Currently selected scale index (0..SCALES_COUNT-1)
 
+// Harmony offsets count scale degrees: distinct semitones, so the repeated
+// entries that pad a row (Pentatonic Minor, the top of every row) are skipped.
+// ScaleDegrees is one row prepared for that at compile time: the degree of
+// every step and the semitone of every degree, so resolving a (step, harmony)
+// pair is two reads instead of a walk along the row.
+struct ScaleDegrees
+{
+    uint8_t degree[SCALE_STEPS];   // Degree (distinct-semitone rank) of each step
+    uint8_t semitone[SCALE_STEPS]; // Semitone offset of each degree
+    uint8_t count;                 // Number of distinct semitones in the row
+
+    // Semitone offset of step moved by harmony degrees, clamped to the row
+    constexpr uint8_t resolve(int step, int harmony) const
+    {
+        const int d = degree[step] + harmony;
+        return semitone[d < 0 ? 0 : (d < count ? d : count - 1)];
+    }
+};
+
+extern const std::array<ScaleDegrees, SCALES_COUNT> scaleDegrees; // Built from scale[] at compile time
+
 #endif // SCALES_H
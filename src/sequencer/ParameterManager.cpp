@@ -3,84 +3,196 @@
 #include <cmath>     // For roundf
 #include <random>    // For std::default_random_engine, std::uniform_real_distribution
 #include <chrono>    // For std::chrono::system_clock (for seeding)
-#include <variant>   // For std::visit
+#include <variant>   // For std::get
 #include "../sensors/as5600.h" // For AS5600ParameterMode
 #include "../sensors/AS5600Manager.h" // For MAX_DELAY_SAMPLES extern declaration
 
 // AS5600 parameter bounds management functions moved to src/sensors/AS5600Manager.cpp
 
-// Helper function to safely get float from ParameterValueType variant
-// This function is internal to ParameterManager.cpp
-static float getFloatFromParameterValueType(const ParameterValueType &v)
+// CORE_PARAMETERS values as floats, resolved at compile time so writes do
+// not visit the variants. Internal to ParameterManager.cpp
+static constexpr float toFloat(const ParameterValueType &v)
 {
-    return std::visit([](auto &&arg) -> float
-                      {
-                          using T = std::decay_t<decltype(arg)>;
-                          if constexpr (std::is_same_v<T, float>)
-                              return arg;
-                          if constexpr (std::is_same_v<T, int>)
-                              return static_cast<float>(arg);
-                          if constexpr (std::is_same_v<T, bool>)
-                              return arg ? 1.0f : 0.0f;
-                          return 0.0f; // Fallback for unexpected types
-                      },
-                      v);
+    return v.index() == 0 ? static_cast<float>(std::get<0>(v))
+         : v.index() == 1 ? std::get<1>(v)
+                          : (std::get<2>(v) ? 1.0f : 0.0f);
+}
+
+struct ParameterRanges
+{
+    float defaultValue[PARAM_ID_COUNT];
+    float minValue[PARAM_ID_COUNT];
+    float maxValue[PARAM_ID_COUNT];
+
+    constexpr ParameterRanges() : defaultValue{}, minValue{}, maxValue{}
+    {
+        for (size_t i = 0; i < PARAM_ID_COUNT; ++i)
+        {
+            defaultValue[i] = toFloat(CORE_PARAMETERS[i].defaultValue);
+            minValue[i] = toFloat(CORE_PARAMETERS[i].minValue);
+            maxValue[i] = toFloat(CORE_PARAMETERS[i].maxValue);
+        }
+    }
+};
+static constexpr ParameterRanges RANGES{};
+
+// Clamping and rounding based on the parameter definition
+static float constrainValue(size_t id, float value)
+{
+    float clampedValue = std::max(RANGES.minValue[id], std::min(value, RANGES.maxValue[id]));
+
+    if (CORE_PARAMETERS[id].isBinary)
+    { // For boolean parameters, round to 0 or 1
+        clampedValue = (clampedValue > 0.5f) ? 1.0f : 0.0f;
+    }
+    else if (CORE_PARAMETERS[id].minValue.index() == 0)
+    { // If min value is int, assume integer parameter
+        clampedValue = roundf(clampedValue);
+    }
+    return clampedValue;
 }
 
 ParameterManager::ParameterManager()
+    : _version(0), _lockState(0), _updateDepth{0, 0}, _pendingDirty{}
 {
+    for (auto &word : _dirtySteps)
+    {
+        word.store(0, std::memory_order_relaxed);
+    }
     // Initialize the spin lock in the constructor
     _lock = spin_lock_init(spin_lock_claim_unused(true)); // Claim a unique lock number
 }
 
 void ParameterManager::init()
 {
+    beginUpdate();
     for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
     {
         // Initialize each track with its default value from CORE_PARAMETERS
-        _tracks[i].init(getFloatFromParameterValueType(CORE_PARAMETERS[i].defaultValue));
+        const float defaultValue = RANGES.defaultValue[i];
+        const float maxValue = RANGES.maxValue[i];
+        back().with(i, [defaultValue, maxValue](auto &track) -> void { track.init(defaultValue, maxValue); });
     }
+    markAllStepsDirty();
+    endUpdate();
 }
 
-void ParameterManager::setStepCount(ParamId id, uint8_t steps)
+void ParameterManager::beginUpdate()
 {
-    _tracks[static_cast<size_t>(id)].resize(steps);
+    uint8_t &depth = _updateDepth[get_core_num()];
+    if (depth == 0)
+    {
+        _lockState = spin_lock_blocking(_lock);
+        // Start from the published tracks; readers may still be on them
+        back() = _banks[_version.load(std::memory_order_relaxed) & 1u];
+    }
+    depth++;
 }
 
-uint8_t ParameterManager::getStepCount(ParamId id) const
+void ParameterManager::endUpdate()
 {
-    uint8_t count = _tracks[static_cast<size_t>(id)].stepCount;
-    return count;
+    uint8_t &depth = _updateDepth[get_core_num()];
+    if (depth == 0 || --depth > 0)
+    {
+        return;
+    }
+    // Release: the edited bank is complete before readers can pick it up
+    _version.fetch_add(1, std::memory_order_release);
+    // Flag changed steps only now, so whoever takes a flag sees the new bank
+    for (size_t w = 0; w < DIRTY_WORDS; ++w)
+    {
+        if (_pendingDirty[w])
+        {
+            _dirtySteps[w].fetch_or(_pendingDirty[w], std::memory_order_release);
+            _pendingDirty[w] = 0;
+        }
+    }
+    spin_unlock(_lock, _lockState);
 }
 
-float ParameterManager::getValue(ParamId id, uint8_t stepIdx) const
+void ParameterManager::markStepsDirty(ParamId id, uint8_t stepIdx)
 {
-    float value = _tracks[static_cast<size_t>(id)].getValue(stepIdx);
-    return value;
+    // A track shorter than SEQUENCER_MAX_STEPS repeats, so one stored value
+    // shows up on every step with the same index modulo the length
+    const uint8_t count = back().stepCount(static_cast<size_t>(id));
+    if (count == 0)
+    {
+        return;
+    }
+    for (uint32_t step = stepIdx % count; step < SEQUENCER_MAX_STEPS; step += count)
+    {
+        _pendingDirty[step / 32] |= 1u << (step % 32);
+    }
 }
 
-void ParameterManager::setValue(ParamId id, uint8_t stepIdx, float value)
+void ParameterManager::markAllStepsDirty()
 {
+    for (size_t w = 0; w < DIRTY_WORDS; ++w)
+    {
+        _pendingDirty[w] = ~0u;
+    }
+}
 
-    // Apply clamping and rounding based on parameter definition
-    const auto &paramDef = CORE_PARAMETERS[static_cast<size_t>(id)];
-    float minVal = getFloatFromParameterValueType(paramDef.minValue);
-    float maxVal = getFloatFromParameterValueType(paramDef.maxValue);
+void ParameterManager::setStepCount(ParamId id, uint8_t steps)
+{
+    beginUpdate();
+    back().with(static_cast<size_t>(id), [steps](auto &track) -> void { track.resize(steps); });
+    markAllStepsDirty();
+    endUpdate();
+}
 
-    float clampedValue = std::max(minVal, std::min(value, maxVal));
+uint8_t ParameterManager::getStepCount(ParamId id) const
+{
+    return read([id](const Bank &bank) { return bank.stepCount(static_cast<size_t>(id)); });
+}
 
-    if (paramDef.isBinary)
-    { // For boolean parameters, round to 0 or 1
-        clampedValue = (clampedValue > 0.5f) ? 1.0f : 0.0f;
-    }
-    else if (paramDef.minValue.index() == 0)
-    { // If min value is int, assume integer parameter
-        clampedValue = roundf(clampedValue);
-    }
+void ParameterManager::getStepCounts(uint8_t (&counts)[static_cast<size_t>(ParamId::Count)]) const
+{
+    read([&counts](const Bank &bank) {
+        for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+        {
+            counts[i] = bank.stepCount(i);
+        }
+        return 0;
+    });
+}
+
+float ParameterManager::getValue(ParamId id, uint8_t stepIdx) const
+{
+    return read([id, stepIdx](const Bank &bank) { return bank.getValue(static_cast<size_t>(id), stepIdx); });
+}
+
+void ParameterManager::getStepValues(uint8_t stepIdx, float (&values)[static_cast<size_t>(ParamId::Count)]) const
+{
+    read([&values, stepIdx](const Bank &bank) {
+        for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+        {
+            values[i] = bank.getValue(i, stepIdx);
+        }
+        return 0;
+    });
+}
 
+void ParameterManager::getValuesAt(const uint8_t (&stepIdx)[static_cast<size_t>(ParamId::Count)],
+                                   float (&values)[static_cast<size_t>(ParamId::Count)]) const
+{
+    read([&values, &stepIdx](const Bank &bank) {
+        for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+        {
+            values[i] = bank.getValue(i, stepIdx[i]);
+        }
+        return 0;
+    });
+}
 
+void ParameterManager::setValue(ParamId id, uint8_t stepIdx, float value)
+{
+    const float clampedValue = constrainValue(static_cast<size_t>(id), value);
 
-    _tracks[static_cast<size_t>(id)].setValue(stepIdx, clampedValue);
+    beginUpdate();
+    back().setValue(static_cast<size_t>(id), stepIdx, clampedValue);
+    markStepsDirty(id, stepIdx);
+    endUpdate();
 }
 
 void ParameterManager::randomizeParameters()
@@ -88,70 +200,161 @@ void ParameterManager::randomizeParameters()
     // Use a better random number generator
     static std::default_random_engine generator(std::chrono::system_clock::now().time_since_epoch().count());
 
+    // Distributions are built once per call, not once per step
+    std::uniform_int_distribution<int> slideDist(0, 12);
+    std::uniform_int_distribution<int> evenGateDist(0, 3); // Even steps: 75% chance of being 1
+    std::uniform_int_distribution<int> oddGateDist(0, 2);  // Odd steps: 33% chance of being 1
+    std::uniform_real_distribution<float> gateLengthDist(0.1f, 0.3f);
+    std::uniform_real_distribution<float> filterDist(0.2f, 0.7f);
+    std::uniform_real_distribution<float> attackDist(0.0f, 0.05f);
+    std::uniform_real_distribution<float> decayDist(0.01f, 0.5f);
+
+    beginUpdate();
+    Bank &tracks = back();
     for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
     {
         ParamId currentParamId = static_cast<ParamId>(i);
+        std::uniform_real_distribution<float> distribution(RANGES.minValue[i], RANGES.maxValue[i]);
 
-        // When randomizing, ensure the Slide parameter's length is set to max
-        if (currentParamId == ParamId::Slide)
-        {
-            _tracks[i].stepCount = 16;
-        }
-
-        const auto &paramDef = CORE_PARAMETERS[i];
-        float minVal = getFloatFromParameterValueType(paramDef.minValue);
-        float maxVal = getFloatFromParameterValueType(paramDef.maxValue);
-        std::uniform_real_distribution<float> distribution(minVal, maxVal);
-
-        for (uint8_t step = 0; step < _tracks[i].stepCount; ++step)
-        {
+        auto nextValue = [&](uint8_t step) -> float {
             switch (currentParamId)
             {
-            case ParamId::Slide: {
-                std::uniform_int_distribution<int> slide_dist(0, 12);
-                _tracks[i].setValue(step, (slide_dist(generator) == 0) ? 1.0f : 0.0f);
-                break;
-            }
-            case ParamId::Gate: {
-                if ((step % 2) == 0) { // Even steps
-                    // 75% chance of being 1
-                    std::uniform_int_distribution<int> gate_dist(0, 3);
-                    _tracks[i].setValue(step, (gate_dist(generator) == 0) ? 0.0f : 1.0f);
-                } else { // Odd steps
-                    // 33% chance of being 1
-                    std::uniform_int_distribution<int> gate_dist(0, 2);
-                    _tracks[i].setValue(step, (gate_dist(generator) == 0) ? 1.0f : 0.0f);
-                }
-                break;
-            }
-            case ParamId::GateLength: { // Corrected from GateSize
-                std::uniform_real_distribution<float> dist(0.1f, 0.3f);
-                _tracks[i].setValue(step, dist(generator));
-                break;
-            }
-            case ParamId::Filter: {
-                std::uniform_real_distribution<float> dist(0.2f, 0.7f);
-                _tracks[i].setValue(step, dist(generator));
-                break;
-            }
-            case ParamId::Attack: {
-                std::uniform_real_distribution<float> dist(0.0f, 0.05f);
-                _tracks[i].setValue(step, dist(generator));
-                break;
-            }
-            case ParamId::Decay: {
-                std::uniform_real_distribution<float> dist(0.01f, 0.5f);
-                _tracks[i].setValue(step, dist(generator));
-                break;
-            }
+            case ParamId::Slide:
+                return (slideDist(generator) == 0) ? 1.0f : 0.0f;
+            case ParamId::Gate:
+                return ((step % 2) == 0) ? ((evenGateDist(generator) == 0) ? 0.0f : 1.0f)
+                                         : ((oddGateDist(generator) == 0) ? 1.0f : 0.0f);
+            case ParamId::GateLength: // Corrected from GateSize
+                return gateLengthDist(generator);
+            case ParamId::Filter:
+                return filterDist(generator);
+            case ParamId::Attack:
+                return attackDist(generator);
+            case ParamId::Decay:
+                return decayDist(generator);
             case ParamId::Note:
             case ParamId::Velocity:
             case ParamId::Octave:
-            default: {
-                _tracks[i].setValue(step, distribution(generator));
-                break;
+            default:
+                return distribution(generator);
+            }
+        };
+
+        // One pass straight over the track's storage
+        tracks.with(i, [&](auto &track) -> void {
+            // When randomizing, ensure the Slide parameter's length is set to max
+            if (currentParamId == ParamId::Slide)
+            {
+                track.stepCount = 16;
             }
+            for (uint8_t step = 0; step < track.stepCount; ++step)
+            {
+                track.setValue(step, nextValue(step));
             }
+        });
+    }
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::fillTrack(ParamId id, float value)
+{
+    const float clampedValue = constrainValue(static_cast<size_t>(id), value);
+
+    beginUpdate();
+    back().with(static_cast<size_t>(id), [clampedValue](auto &track) -> void { track.fill(clampedValue); });
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::clearTrack(ParamId id)
+{
+    fillTrack(id, RANGES.defaultValue[static_cast<size_t>(id)]);
+}
+
+void ParameterManager::clearAll()
+{
+    beginUpdate();
+    for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+    {
+        const float defaultValue = RANGES.defaultValue[i];
+        back().with(i, [defaultValue](auto &track) -> void { track.fill(defaultValue); });
+    }
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::rotateTrack(ParamId id, int steps)
+{
+    beginUpdate();
+    back().with(static_cast<size_t>(id), [steps](auto &track) -> void { track.rotate(steps); });
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::reverseTrack(ParamId id)
+{
+    beginUpdate();
+    back().with(static_cast<size_t>(id), [](auto &track) -> void { track.reverse(); });
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::offsetTrack(ParamId id, float delta)
+{
+    const size_t i = static_cast<size_t>(id);
+    if (CORE_PARAMETERS[i].isBinary)
+    {
+        return; // Nothing to shift on an on/off track
+    }
+    const float minValue = RANGES.minValue[i];
+    const float maxValue = RANGES.maxValue[i];
+
+    beginUpdate();
+    back().with(i, [delta, minValue, maxValue](auto &track) -> void { track.offset(delta, minValue, maxValue); });
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::copyTrackFrom(const ParameterManager &other, ParamId id)
+{
+    if (&other == this)
+    {
+        return;
+    }
+    const size_t i = static_cast<size_t>(id);
+
+    beginUpdate();
+    Bank &dest = back();
+    // Copy the other sequencer's published track, retrying if it publishes meanwhile
+    other.read([&dest, i](const Bank &src) {
+        if (CORE_PARAMETERS[i].isBinary)
+        {
+            dest.binary[SLOTS.slot[i]] = src.binary[SLOTS.slot[i]];
         }
+        else
+        {
+            dest.quantized[SLOTS.slot[i]] = src.quantized[SLOTS.slot[i]];
+        }
+        return 0;
+    });
+    markAllStepsDirty();
+    endUpdate();
+}
+
+void ParameterManager::copyFrom(const ParameterManager &other)
+{
+    if (&other == this)
+    {
+        return;
     }
-}
\ No newline at end of file
+
+    beginUpdate();
+    Bank &dest = back();
+    other.read([&dest](const Bank &src) {
+        dest = src;
+        return 0;
+    });
+    markAllStepsDirty();
+    endUpdate();
+}
@@ -3,9 +3,35 @@
 
 #include "SequencerDefs.h" // For ParamId, ParameterTrack, CORE_PARAMETERS, AS5600ParameterMode
 #include "pico/sync.h"     // For spin_lock_t
+#include <atomic>
+
+// Position of each parameter within its storage group (binary or quantized)
+struct ParameterTrackSlots
+{
+    uint8_t slot[PARAM_ID_COUNT];
+    uint8_t binaryCount;
+    uint8_t quantizedCount;
+
+    constexpr ParameterTrackSlots() : slot{}, binaryCount(0), quantizedCount(0)
+    {
+        for (size_t i = 0; i < PARAM_ID_COUNT; ++i)
+        {
+            slot[i] = CORE_PARAMETERS[i].isBinary ? binaryCount++ : quantizedCount++;
+        }
+    }
+};
 
 /**
  * @brief Manages all parameter tracks for a sequencer, providing thread-safe access.
+ *
+ * The tracks are double-buffered. Readers (advanceStep() in the clock ISR,
+ * the LED and OLED code) never lock: they read the published bank and retry
+ * if a new one was published meanwhile. Writers edit the other bank under
+ * the hardware spin lock and publish it with a single version increment, so
+ * a batch of edits between beginUpdate() and endUpdate() appears at once.
+ *
+ * Binary parameters take one bit per step, the others 16-bit fixed point
+ * (see QuantizedValues), so values read back rounded to the track's scale.
  */
 class ParameterManager {
 public:
@@ -18,15 +44,120 @@ public:
 
     void setStepCount(ParamId id, uint8_t steps);
     uint8_t getStepCount(ParamId id) const;
+
+    /**
+     * @brief Reads the step count of every track from the same published bank.
+     */
+    void getStepCounts(uint8_t (&counts)[static_cast<size_t>(ParamId::Count)]) const;
     float getValue(ParamId id, uint8_t stepIdx) const;
+
+    /**
+     * @brief Reads every parameter of one step from the same published bank.
+     */
+    void getStepValues(uint8_t stepIdx, float (&values)[static_cast<size_t>(ParamId::Count)]) const;
+
+    /**
+     * @brief Like getStepValues(), with each parameter read at its own step.
+     */
+    void getValuesAt(const uint8_t (&stepIdx)[static_cast<size_t>(ParamId::Count)],
+                     float (&values)[static_cast<size_t>(ParamId::Count)]) const;
     void setValue(ParamId id, uint8_t stepIdx, float value);
     void randomizeParameters();
 
+    /**
+     * @brief Whole-track and whole-pattern edits. Each runs in one pass over
+     * the track storage and is published at once; wrap several in
+     * beginUpdate()/endUpdate() to publish them together.
+     */
+    void fillTrack(ParamId id, float value);       // every step, clamped like setValue()
+    void clearTrack(ParamId id);                    // every step back to the default
+    void clearAll();                                // every track back to its default
+    void rotateTrack(ParamId id, int steps);        // positive moves step i to i + steps
+    void reverseTrack(ParamId id);                  // reverses the active steps
+    void offsetTrack(ParamId id, float delta);      // adds delta, clamped; ignored for binary tracks
+    void copyTrackFrom(const ParameterManager &other, ParamId id); // values and length
+    void copyFrom(const ParameterManager &other);   // every track
+
+    /**
+     * @brief Groups writes so readers see all of them or none. Calls nest;
+     * the outermost endUpdate() publishes. Interrupts stay disabled on the
+     * writing core in between, so keep batches short.
+     */
+    void beginUpdate();
+    void endUpdate();
+
+    // Incremented by every publish
+    uint32_t getVersion() const { return _version.load(std::memory_order_acquire); }
+
+    static constexpr size_t DIRTY_WORDS = (SEQUENCER_MAX_STEPS + 31) / 32;
+
+    /**
+     * @brief Returns and clears one word of the changed-steps mask: bit b of
+     * word w is step w * 32 + b, set when a publish changed any parameter
+     * that step reads. For a single consumer (the UI loop).
+     */
+    uint32_t takeDirtySteps(size_t word) const { return _dirtySteps[word].exchange(0, std::memory_order_acquire); }
+
     // AS5600 Parameter Bounds Management functions moved to src/sensors/AS5600Manager.h/.cpp
 
 private:
-    ParameterTrack<SEQUENCER_MAX_STEPS> _tracks[static_cast<size_t>(ParamId::Count)];
-    mutable spin_lock_t* _lock; // mutable because const methods (like getValue) need to acquire the lock
+    static constexpr ParameterTrackSlots SLOTS{};
+
+    struct Bank {
+        ParameterTrack<QuantizedValues<SEQUENCER_MAX_STEPS>, SEQUENCER_MAX_STEPS> quantized[SLOTS.quantizedCount];
+        ParameterTrack<BinaryValues<SEQUENCER_MAX_STEPS>, SEQUENCER_MAX_STEPS> binary[SLOTS.binaryCount];
+
+        // Calls fn with the track of parameter id, whichever group it is in
+        template <typename Fn>
+        auto with(size_t id, Fn fn) -> decltype(fn(binary[0])) {
+            return CORE_PARAMETERS[id].isBinary ? fn(binary[SLOTS.slot[id]]) : fn(quantized[SLOTS.slot[id]]);
+        }
+        template <typename Fn>
+        auto with(size_t id, Fn fn) const -> decltype(fn(binary[0])) {
+            return CORE_PARAMETERS[id].isBinary ? fn(binary[SLOTS.slot[id]]) : fn(quantized[SLOTS.slot[id]]);
+        }
+
+        uint8_t stepCount(size_t id) const { return with(id, [](const auto &t) { return t.stepCount; }); }
+        float getValue(size_t id, uint8_t stepIdx) const {
+            return with(id, [stepIdx](const auto &t) { return t.getValue(stepIdx); });
+        }
+        void setValue(size_t id, uint8_t stepIdx, float value) {
+            with(id, [stepIdx, value](auto &t) -> void { t.setValue(stepIdx, value); });
+        }
+    };
+
+    // Runs reader on the published bank until no publish happened meanwhile.
+    // A writer reads its own unpublished edits; nothing else can run on its
+    // core during a batch
+    template <typename Reader>
+    auto read(Reader reader) const -> decltype(reader(*static_cast<const Bank*>(nullptr))) {
+        if (_updateDepth[get_core_num()] > 0) {
+            return reader(_banks[(_version.load(std::memory_order_relaxed) + 1u) & 1u]);
+        }
+        for (;;) {
+            const uint32_t version = _version.load(std::memory_order_acquire);
+            auto result = reader(_banks[version & 1u]);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_version.load(std::memory_order_relaxed) == version) {
+                return result;
+            }
+        }
+    }
+
+    // Bank being edited; only valid between beginUpdate() and endUpdate()
+    Bank& back() { return _banks[(_version.load(std::memory_order_relaxed) + 1u) & 1u]; }
+
+    // Writer side: steps to flag at the next publish
+    void markStepsDirty(ParamId id, uint8_t stepIdx);
+    void markAllStepsDirty();
+
+    Bank _banks[2];
+    std::atomic<uint32_t> _version; // _banks[_version & 1] is published
+    spin_lock_t* _lock;             // serializes writers (and masks the clock ISR)
+    uint32_t _lockState;
+    uint8_t _updateDepth[2];        // per core, so a reader only checks its own
+    uint32_t _pendingDirty[DIRTY_WORDS];                     // writer only, under _lock
+    mutable std::atomic<uint32_t> _dirtySteps[DIRTY_WORDS];  // published, taken by the reader
 };
 
 #endif // PARAMETER_MANAGER_H
\ No newline at end of file
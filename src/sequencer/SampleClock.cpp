@@ -0,0 +1,121 @@
+#include "SampleClock.h"
+#include <algorithm> // For std::min, std::max
+#include <cmath>     // For lroundf
+
+SampleClock::SampleClock()
+    : _onTick(nullptr), _onStep(nullptr), _tickLength(1), _samplePeriod(1), _milliBpm(120000),
+      _running(false), _tick(0), _step(0), _nextTickSample(0), _overshoot(0), _position(0),
+      _shuffle{}, _shuffleSize(0), _shuffleOn(false)
+{
+}
+
+void SampleClock::init(float sampleRate)
+{
+    // Ticks per sample = milliBpm * PPQN / (sampleRate * 60000), kept as two
+    // integers so no rounding error can build up
+    _tickLength = static_cast<uint64_t>(lroundf(sampleRate)) * 60000u;
+    setTempo(getTempo());
+}
+
+void SampleClock::setTempo(float bpm)
+{
+    bpm = std::max(MIN_BPM, std::min(bpm, MAX_BPM));
+    _milliBpm = static_cast<uint32_t>(lroundf(bpm * 1000.0f));
+
+    const uint64_t samplePeriod = static_cast<uint64_t>(_milliBpm) * PULSES_PER_QUARTER_NOTE;
+    if (_running)
+    {
+        // What is left of the tick in progress, in rate units (tempo
+        // independent). When advanceTo() stopped on the tick's own sample its
+        // exact instant may already lie behind _position: nothing is left,
+        // and the tick fires on _position
+        const int64_t ahead = static_cast<int32_t>(_nextTickSample - _position);
+        const int64_t remaining = ahead * static_cast<int64_t>(_samplePeriod) - static_cast<int64_t>(_overshoot);
+        const uint64_t left = remaining > 0 ? static_cast<uint64_t>(remaining) : 0;
+
+        // Cover the rest of the tick at the new rate, starting from _position
+        const uint64_t samples = (left + samplePeriod - 1) / samplePeriod;
+        _nextTickSample = _position + static_cast<uint32_t>(samples);
+        _overshoot = samples * samplePeriod - left;
+    }
+    _samplePeriod = samplePeriod;
+}
+
+void SampleClock::setShuffleTemplate(const int8_t *ticks, uint8_t size)
+{
+    _shuffleSize = ticks ? std::min(size, MAX_SHUFFLE_SIZE) : 0;
+    for (uint8_t i = 0; i < _shuffleSize; ++i)
+    {
+        _shuffle[i] = ticks[i];
+    }
+}
+
+void SampleClock::start(uint32_t atSample)
+{
+    _tick = 0;
+    _step = 0;
+    _nextTickSample = atSample;
+    _overshoot = 0;
+    _position = atSample;
+    _running = true;
+}
+
+void SampleClock::resume(uint32_t atSample)
+{
+    _nextTickSample = atSample;
+    _overshoot = 0;
+    _position = atSample;
+    _running = true;
+}
+
+int64_t SampleClock::nextStepTick() const
+{
+    int64_t t = static_cast<int64_t>(_step) * PULSES_PER_SEQUENCER_STEP;
+    if (_shuffleOn && _shuffleSize > 0)
+    {
+        t += _shuffle[_step % _shuffleSize];
+    }
+    return t < 0 ? 0 : t;
+}
+
+void SampleClock::retime()
+{
+    // Next exact tick instant is one tick length after this one; land on the
+    // first sample at or after it and remember by how much it was overshot
+    const uint64_t toNext = _tickLength - _overshoot;
+    const uint64_t samples = (toNext + _samplePeriod - 1) / _samplePeriod;
+    _nextTickSample += static_cast<uint32_t>(samples);
+    _overshoot = samples * _samplePeriod - toNext;
+}
+
+void SampleClock::advanceTo(uint32_t until)
+{
+    if (!_running)
+    {
+        _position = until;
+        return;
+    }
+
+    // Signed difference so the comparison survives the 32-bit wrap
+    while (static_cast<int32_t>(_nextTickSample - until) < 0)
+    {
+        const uint32_t atSample = _nextTickSample;
+        if (_onTick)
+        {
+            _onTick(_tick, atSample);
+        }
+        // >= rather than ==: a template change can move the next step
+        // behind the current tick, which must not stall the sequencer
+        while (static_cast<int64_t>(_tick) >= nextStepTick())
+        {
+            if (_onStep)
+            {
+                _onStep(_step, atSample);
+            }
+            ++_step;
+        }
+        ++_tick;
+        retime();
+    }
+    _position = until;
+}
@@ -0,0 +1,103 @@
+#ifndef SAMPLE_CLOCK_H
+#define SAMPLE_CLOCK_H
+
+#include <stdint.h>
+#include "SequencerDefs.h" // For PULSES_PER_QUARTER_NOTE, PULSES_PER_SEQUENCER_STEP
+
+/**
+ * @brief Sequencer clock driven by the audio sample counter instead of a timer.
+ *
+ * Derives the 480 PPQN tick from sample positions on the VoiceManager
+ * sample timeline, so the sequencer cannot drift against the I2S clock.
+ * Tempo is held as an exact ratio (milli-BPM against the sample rate) and
+ * the fractional tick carries from one tick to the next, so the tempo stays
+ * exact over any run length and every tick, step and shuffle offset lands
+ * on the same sample each time a pattern is played.
+ *
+ * Steps fire every PULSES_PER_SEQUENCER_STEP ticks, moved by the shuffle
+ * template the same way uClock's setShuffleTemplate() does. Callbacks run
+ * in the context that calls advanceTo() and get the sample their tick falls
+ * on, ready to stamp VoiceManager commands with.
+ */
+class SampleClock {
+public:
+    typedef void (*TickCallback)(uint32_t tick, uint32_t atSample);
+    typedef void (*StepCallback)(uint32_t step, uint32_t atSample);
+
+    static constexpr uint8_t MAX_SHUFFLE_SIZE = 16;
+    static constexpr float MIN_BPM = 1.0f;
+    static constexpr float MAX_BPM = 999.0f;
+
+    SampleClock();
+
+    void init(float sampleRate);
+
+    /**
+     * @brief Changes the tempo; the tick in progress keeps the fraction it
+     * has already covered.
+     */
+    void setTempo(float bpm);
+    float getTempo() const { return static_cast<float>(_milliBpm) * 0.001f; }
+
+    /**
+     * @brief Copies a template of per-step tick offsets (positive delays the
+     * step). Takes effect from the next step.
+     */
+    void setShuffleTemplate(const int8_t *ticks, uint8_t size);
+    void setShuffle(bool enabled) { _shuffleOn = enabled; }
+
+    void setOnTick(TickCallback callback) { _onTick = callback; }
+    void setOnStep(StepCallback callback) { _onStep = callback; }
+
+    /**
+     * @brief Restarts at tick 0 and step 0 on sample atSample.
+     */
+    void start(uint32_t atSample);
+
+    /**
+     * @brief Halts tick generation; advanceTo() fires nothing until start()
+     * or resume().
+     */
+    void stop() { _running = false; }
+
+    /**
+     * @brief Picks up after stop() with the next tick and step on sample
+     * atSample, so the step count carries on where it halted.
+     */
+    void resume(uint32_t atSample);
+    bool isRunning() const { return _running; }
+
+    /**
+     * @brief Fires every tick (and step) that falls before sample `until`.
+     * Sample times wrap with the 32-bit VoiceManager timeline.
+     */
+    void advanceTo(uint32_t until);
+
+    uint32_t getTick() const { return _tick; }
+    uint32_t getStep() const { return _step; }
+    uint32_t getNextTickSample() const { return _nextTickSample; }
+
+private:
+    int64_t nextStepTick() const;
+    void retime();
+
+    TickCallback _onTick;
+    StepCallback _onStep;
+
+    uint64_t _tickLength;     // one tick, in rate units (sample rate * 60000)
+    uint64_t _samplePeriod;   // one sample, in rate units (milli-BPM * PPQN)
+    uint32_t _milliBpm;
+
+    bool _running;
+    uint32_t _tick;           // next tick to fire
+    uint32_t _step;           // next step to fire
+    uint32_t _nextTickSample; // first sample at or after the exact tick instant
+    uint64_t _overshoot;      // how far _nextTickSample lies past that instant, in rate units
+    uint32_t _position;       // last `until` passed to advanceTo()
+
+    int8_t _shuffle[MAX_SHUFFLE_SIZE];
+    uint8_t _shuffleSize;
+    bool _shuffleOn;
+};
+
+#endif // SAMPLE_CLOCK_H
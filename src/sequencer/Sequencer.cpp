@@ -1,6 +1,7 @@
 #include <cstdint>
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 #include "SequencerDefs.h"
 #include "Sequencer.h"
 #include "Arduino.h"
@@ -66,7 +67,15 @@ Sequencer::Sequencer()
     for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
     {
         currentStepPerParam[i] = 0;
+        counterLength[i] = 0;
     }
+    lastSongStep = 0;
+    countersValid = false;
+#if SEQUENCER_UNROLLED_CYCLE
+    unrolledLength = 0;
+    unrolledVersion = 0;
+    unrolledValid.store(false, std::memory_order_relaxed);
+#endif
     
     // Initialize GPIO pins for gate outputs and step clock
     pinMode(10, OUTPUT);  // Voice 1 gate output
@@ -90,7 +99,15 @@ Sequencer::Sequencer(uint8_t channel)
     for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
     {
         currentStepPerParam[i] = 0;
+        counterLength[i] = 0;
     }
+    lastSongStep = 0;
+    countersValid = false;
+#if SEQUENCER_UNROLLED_CYCLE
+    unrolledLength = 0;
+    unrolledVersion = 0;
+    unrolledValid.store(false, std::memory_order_relaxed);
+#endif
     
     // Initialize GPIO pins for gate outputs and step clock
     pinMode(10, OUTPUT);  // Voice 1 gate output
@@ -154,6 +171,7 @@ void Sequencer::reset()
     {
         currentStepPerParam[i] = 0;
     }
+    countersValid = false; // Whatever step comes next, recompute from scratch
     running = false;
     previousStepHadSlide = false; // Reset slide state tracking
     handleNoteOff(nullptr); // Pass nullptr as no voice state to update
@@ -166,28 +184,100 @@ uint8_t Sequencer::getCurrentStepForParameter(ParamId paramId) const
 
 void Sequencer::resetAllSteps()
 {
-    // Data-driven reset using the defaults from CORE_PARAMETERS
+    // Every track back to its CORE_PARAMETERS default, published at once
+    parameterManager.clearAll();
+}
+
+void Sequencer::fillTrack(ParamId id, float value)
+{
+    parameterManager.fillTrack(id, value);
+}
+
+void Sequencer::clearTrack(ParamId id)
+{
+    parameterManager.clearTrack(id);
+}
+
+void Sequencer::rotateTrack(ParamId id, int steps)
+{
+    parameterManager.rotateTrack(id, steps);
+}
+
+void Sequencer::reverseTrack(ParamId id)
+{
+    parameterManager.reverseTrack(id);
+}
+
+void Sequencer::rotatePattern(int steps)
+{
+    parameterManager.beginUpdate();
     for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
     {
-        ParamId currentId = static_cast<ParamId>(i);
-        float defaultValue = std::visit(
-            [](auto &&arg) -> float
-            {
-                using T = std::decay_t<decltype(arg)>;
-                if constexpr (std::is_same_v<T, float>) return arg;
-                if constexpr (std::is_same_v<T, int>) return static_cast<float>(arg);
-                if constexpr (std::is_same_v<T, bool>) return arg ? 1.0f : 0.0f;
-                return 0.0f; // Fallback
-            },
-            CORE_PARAMETERS[i].defaultValue);
+        parameterManager.rotateTrack(static_cast<ParamId>(i), steps);
+    }
+    parameterManager.endUpdate();
+}
 
-        for (uint8_t step = 0; step < SEQUENCER_MAX_STEPS; ++step)
+void Sequencer::reversePattern()
+{
+    parameterManager.beginUpdate();
+    for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+    {
+        parameterManager.reverseTrack(static_cast<ParamId>(i));
+    }
+    parameterManager.endUpdate();
+}
+
+void Sequencer::transpose(int degrees)
+{
+    // Note values are scale degrees, so this moves along the current scale
+    parameterManager.offsetTrack(ParamId::Note, static_cast<float>(degrees));
+}
+
+void Sequencer::copyTrackFrom(const Sequencer &other, ParamId id)
+{
+    parameterManager.copyTrackFrom(other.parameterManager, id);
+}
+
+void Sequencer::copyPatternFrom(const Sequencer &other)
+{
+    parameterManager.copyFrom(other.parameterManager);
+}
+
+void Sequencer::updateStepCounters(uint32_t songStep)
+{
+    uint8_t counts[static_cast<size_t>(ParamId::Count)];
+    parameterManager.getStepCounts(counts);
+
+    // The usual case is the step right after the previous one: increment and
+    // wrap. After a jump (start, seek, song position) or a length change the
+    // counter is recomputed, so it always equals songStep % length
+    const bool consecutive = countersValid && songStep == lastSongStep + 1;
+    for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+    {
+        const uint8_t count = counts[i];
+        if (count == 0)
         {
-            setStepParameterValue(currentId, step, defaultValue);
+            currentStepPerParam[i] = 0; // Fallback if no step count is set
         }
+        else if (consecutive && count == counterLength[i])
+        {
+            if (++currentStepPerParam[i] >= count)
+            {
+                currentStepPerParam[i] = 0;
+            }
+        }
+        else
+        {
+            currentStepPerParam[i] = static_cast<uint8_t>(songStep % count);
+        }
+        counterLength[i] = count;
     }
+    lastSongStep = songStep;
+    countersValid = true;
 }
-void Sequencer::advanceStep(uint8_t current_uclock_step, int mm_distance,
+
+void Sequencer::advanceStep(uint32_t song_step, int mm_distance,
                             bool is_note_button_held, bool is_velocity_button_held,
                             bool is_filter_button_held, bool is_attack_button_held,
                             bool is_decay_button_held, bool is_octave_button_held,
@@ -204,34 +294,12 @@ void Sequencer::advanceStep(uint8_t current_uclock_step, int mm_distance,
     digitalWrite(12, HIGH);
     digitalWrite(12, LOW);
 
-    // Use the Gate parameter's step count to determine the main sequence length
-    uint8_t sequenceLength = getParameterStepCount(ParamId::Gate);
-    if (sequenceLength > 0)
-    {
-        currentStep = current_uclock_step % sequenceLength;
-    }
-    else
-    {
-        currentStep = 0; // Fallback if no sequence length is set
-    }
-
     // Advance each parameter's step counter independently based on its own step count
     // This enables polyrhythmic patterns where different parameters cycle at different rates
-    for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
-    {
-        ParamId paramId = static_cast<ParamId>(i);
-        uint8_t paramStepCount = getParameterStepCount(paramId);
+    updateStepCounters(song_step);
 
-        if (paramStepCount > 0)
-        {
-            // Use efficient increment and wrap instead of modulo for performance
-            currentStepPerParam[i] = current_uclock_step % paramStepCount;
-        }
-        else
-        {
-            currentStepPerParam[i] = 0; // Fallback if no step count is set
-        }
-    }
+    // The Gate parameter's step count determines the main sequence length
+    currentStep = currentStepPerParam[static_cast<size_t>(ParamId::Gate)];
 
     // Track if any parameters were recorded during this step
     bool parametersRecorded = false;
@@ -295,11 +363,11 @@ void Sequencer::advanceStep(uint8_t current_uclock_step, int mm_distance,
     // with the new values by processStep() above, providing immediate real-time feedback
 }
 
-void Sequencer::advanceStep(uint8_t current_uclock_step, int mm_distance,
+void Sequencer::advanceStep(uint32_t song_step, int mm_distance,
                             const UIState& uiState, VoiceState *voiceState)
 {
     // Extract button states from UIState and call the main advanceStep method
-    advanceStep(current_uclock_step, mm_distance,
+    advanceStep(song_step, mm_distance,
                 uiState.parameterButtonHeld[static_cast<int>(ParamId::Note)],
                 uiState.parameterButtonHeld[static_cast<int>(ParamId::Velocity)],
                 uiState.parameterButtonHeld[static_cast<int>(ParamId::Filter)],
@@ -315,60 +383,104 @@ void Sequencer::processStep(uint8_t stepIdx, VoiceState *voiceState)
     // This method supports two modes:
     // 1. When stepIdx == UINT8_MAX, use per-parameter step indices (called from advanceStep)
     // 2. When stepIdx is a valid index, use that index for all parameters (called from playStepNow)
-    bool usePerParameterIndices = (stepIdx == UINT8_MAX);
+    applyStep(stepIdx == UINT8_MAX ? resolveCurrentStep() : getStep(stepIdx), voiceState);
+}
+
+Step Sequencer::resolveCurrentStep() const
+{
+#if SEQUENCER_UNROLLED_CYCLE
+    // The table holds songStep % cycle length, which every counter divides
+    if (unrolledValid.load(std::memory_order_acquire) && unrolledVersion == parameterManager.getVersion())
+    {
+        return unrolledSteps[lastSongStep % unrolledLength];
+    }
+#endif
+    float v[static_cast<size_t>(ParamId::Count)];
+    parameterManager.getValuesAt(currentStepPerParam, v);
+    return stepFromValues(v);
+}
 
+#if SEQUENCER_UNROLLED_CYCLE
+void Sequencer::updateUnrolledCycle()
+{
+    const uint32_t version = parameterManager.getVersion();
+    if (version == unrolledVersion)
+    {
+        return; // Already built (or found too long) for these parameters
+    }
+
+    // The clock reads the tracks directly until the new table is complete.
+    // The clock ISR interrupts this core, so a compiler fence is enough to
+    // keep the table writes below from moving ahead of the store
+    unrolledValid.store(false, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    unrolledVersion = version;
+    unrolledLength = 0;
+
+    uint8_t counts[static_cast<size_t>(ParamId::Count)];
+    parameterManager.getStepCounts(counts);
+
+    uint32_t length = 1;
+    for (uint8_t count : counts)
+    {
+        if (count > 0)
+        {
+            length = length / std::gcd(length, static_cast<uint32_t>(count)) * count;
+            if (length > UNROLLED_CYCLE_MAX_STEPS)
+            {
+                return;
+            }
+        }
+    }
+
+    for (uint32_t step = 0; step < length; ++step)
+    {
+        uint8_t stepIdx[static_cast<size_t>(ParamId::Count)];
+        for (size_t i = 0; i < static_cast<size_t>(ParamId::Count); ++i)
+        {
+            stepIdx[i] = counts[i] > 0 ? static_cast<uint8_t>(step % counts[i]) : 0;
+        }
+        float v[static_cast<size_t>(ParamId::Count)];
+        parameterManager.getValuesAt(stepIdx, v);
+        unrolledSteps[step] = stepFromValues(v);
+    }
+
+    if (parameterManager.getVersion() != version)
+    {
+        return; // Edited while building; the next call starts over
+    }
+    unrolledLength = static_cast<uint16_t>(length);
+    unrolledValid.store(true, std::memory_order_release);
+}
+
+uint16_t Sequencer::getUnrolledCycleLength() const
+{
+    const bool current = unrolledValid.load(std::memory_order_acquire) && unrolledVersion == parameterManager.getVersion();
+    return current ? unrolledLength : 0;
+}
+#endif
+
+void Sequencer::applyStep(const Step &s, VoiceState *voiceState)
+{
     if (voiceState)
     {
         voiceState->retrigger = false; // Always reset the retrigger flag at the start
     }
 
-    // Get parameter values using appropriate step indices
-    float gateOn = getStepParameterValue(ParamId::Gate,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Gate)] : stepIdx);
-
-    // Always get parameter values for modulation parameters
-    float filterVal = getStepParameterValue(ParamId::Filter,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Filter)] : stepIdx);
-    float attackVal = getStepParameterValue(ParamId::Attack,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Attack)] : stepIdx);
-    float decayVal = getStepParameterValue(ParamId::Decay,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Decay)] : stepIdx);
-
-    // Get note-related parameters
-    uint8_t noteStepIdx = usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Note)] : stepIdx;
-    float noteVal = getStepParameterValue(ParamId::Note, noteStepIdx);
-    float velocityVal = getStepParameterValue(ParamId::Velocity,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Velocity)] : stepIdx);
-    float octaveFloat = getStepParameterValue(ParamId::Octave,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Octave)] : stepIdx);
-    float slideVal = getStepParameterValue(ParamId::Slide,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::Slide)] : stepIdx);
-
-    // DEBUG: Trace parameter retrieval
-    /*
-    Serial.print("[PARAM DEBUG] Step ");
-    Serial.print(stepIdx);
-    Serial.print(" (noteStepIdx: ");
-    Serial.print(noteStepIdx);
-    Serial.print(") - Retrieved noteVal: ");
-    Serial.print(noteVal, 2);
-    Serial.print(", octaveFloat: ");
-    Serial.print(octaveFloat, 2);
-    Serial.println();
-    */
-    float gateLengthProportion = getStepParameterValue(ParamId::GateLength,
-        usePerParameterIndices ? currentStepPerParam[static_cast<size_t>(ParamId::GateLength)] : stepIdx);
-
-
-
-    const uint16_t noteDurationTicks = static_cast<uint16_t>(std::max(1.0f, gateLengthProportion * PULSES_PER_SEQUENCER_STEP));
-    const int8_t octaveOffset = mapFloatToOctaveOffset(octaveFloat);
-
+    const bool gateOn = s.gate;
+    const bool slideVal = s.slide;
+    const float noteVal = s.note;
+    const float velocityVal = s.velocity;
+    const float filterVal = s.filter;
+    const float attackVal = s.attack;
+    const float decayVal = s.decay;
+    const uint16_t noteDurationTicks = s.gateLength;
+    const int8_t octaveOffset = static_cast<int8_t>(s.octave);
 
     if (gateOn)
     {
         // Calculate the final note value
-        int finalNote = noteVal + octaveOffset;
+        int finalNote = static_cast<int>(noteVal) + octaveOffset;
 
         // If the step's gate is on, decide whether to start a new note or slide to it.
         if (!slideVal)
@@ -503,34 +615,70 @@ void Sequencer::toggleStep(uint8_t stepIdx)
 }
 
 Step Sequencer::getStep(uint8_t stepIdx) const
+{
+    float v[static_cast<size_t>(ParamId::Count)];
+    parameterManager.getStepValues(stepIdx, v);
+    return stepFromValues(v);
+}
+
+Step Sequencer::stepFromValues(const float (&v)[static_cast<size_t>(ParamId::Count)])
 {
     Step s;
-    s.note = getStepParameterValue(ParamId::Note, stepIdx);
-    s.velocity = getStepParameterValue(ParamId::Velocity, stepIdx);
-    s.filter = getStepParameterValue(ParamId::Filter, stepIdx);
-    s.attack = getStepParameterValue(ParamId::Attack, stepIdx);
-    s.decay = getStepParameterValue(ParamId::Decay, stepIdx);
-    s.gate = getStepParameterValue(ParamId::Gate, stepIdx) > 0.5f;
-    s.slide = getStepParameterValue(ParamId::Slide, stepIdx) > 0.5f;
-    s.octave = mapFloatToOctaveOffset(getStepParameterValue(ParamId::Octave, stepIdx));
-
-    const float gateLengthProportion = getStepParameterValue(ParamId::GateLength, stepIdx);
+    s.note = v[static_cast<size_t>(ParamId::Note)];
+    s.velocity = v[static_cast<size_t>(ParamId::Velocity)];
+    s.filter = v[static_cast<size_t>(ParamId::Filter)];
+    s.attack = v[static_cast<size_t>(ParamId::Attack)];
+    s.decay = v[static_cast<size_t>(ParamId::Decay)];
+    s.gate = v[static_cast<size_t>(ParamId::Gate)] > 0.5f;
+    s.slide = v[static_cast<size_t>(ParamId::Slide)] > 0.5f;
+    s.octave = mapFloatToOctaveOffset(v[static_cast<size_t>(ParamId::Octave)]);
+
+    const float gateLengthProportion = v[static_cast<size_t>(ParamId::GateLength)];
     s.gateLength = static_cast<uint16_t>(std::max(1.0f, gateLengthProportion * PULSES_PER_SEQUENCER_STEP));
     return s;
 }
 
-void Sequencer::randomizeParameters()
+const PackedStep* Sequencer::getPackedSteps() const
 {
-    parameterManager.randomizeParameters();
-    for (size_t i = 0; i < 16; ++i){
-setStepParameterValue(ParamId::Octave, i, 0.0f);
-setStepParameterValue(ParamId::Attack, i, 0.001f);
-setStepParameterValue(ParamId::Decay, i, 0.12f);
+    for (size_t word = 0; word < ParameterManager::DIRTY_WORDS; ++word)
+    {
+        uint32_t dirty = parameterManager.takeDirtySteps(word);
+        while (dirty)
+        {
+            refreshPackedStep(static_cast<uint8_t>(word * 32 + __builtin_ctz(dirty)));
+            dirty &= dirty - 1; // Clear the lowest set bit
+        }
+    }
+    return packedSteps;
+}
 
+void Sequencer::refreshPackedStep(uint8_t stepIdx) const
+{
+    float v[static_cast<size_t>(ParamId::Count)];
+    parameterManager.getStepValues(stepIdx, v);
+
+    // 0.0 to 1.0 onto 0 to 255
+    auto toByte = [](float x) { return static_cast<uint8_t>(lroundf(std::max(0.0f, std::min(x, 1.0f)) * 255.0f)); };
+
+    PackedStep &p = packedSteps[stepIdx];
+    p.flags = (v[static_cast<size_t>(ParamId::Gate)] > 0.5f ? PackedStep::GATE : 0) |
+              (v[static_cast<size_t>(ParamId::Slide)] > 0.5f ? PackedStep::SLIDE : 0);
+    p.note = static_cast<uint8_t>(lroundf(std::max(0.0f, std::min(v[static_cast<size_t>(ParamId::Note)], 255.0f))));
+    p.velocity = toByte(v[static_cast<size_t>(ParamId::Velocity)]);
+    p.filter = toByte(v[static_cast<size_t>(ParamId::Filter)]);
+    p.octave = mapFloatToOctaveOffset(v[static_cast<size_t>(ParamId::Octave)]);
+}
 
-    }
+void Sequencer::randomizeParameters()
+{
+    // One publish: playback never sees half a randomized pattern
+    parameterManager.beginUpdate();
+    parameterManager.randomizeParameters();
+    parameterManager.fillTrack(ParamId::Octave, 0.0f);
+    parameterManager.fillTrack(ParamId::Attack, 0.001f);
+    parameterManager.fillTrack(ParamId::Decay, 0.12f);
    // setParameterStepCount(ParamId::Octave, random(2,8));
-    
+    parameterManager.endUpdate();
 }
 
 void Sequencer::triggerEnvelope()
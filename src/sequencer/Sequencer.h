@@ -3,6 +3,16 @@
 #include "SequencerDefs.h"
 #include "ParameterManager.h"
 #include "../ui/UIState.h"
+#include <atomic>
+
+// Build-time option. 1 keeps a table of every step of the full polyrhythmic
+// cycle (the LCM of all track lengths, up to UNROLLED_CYCLE_MAX_STEPS), so
+// advanceStep() reads one precomputed Step instead of nine tracks. The table
+// is rebuilt by updateUnrolledCycle() on the UI loop after every edit; until
+// then advanceStep() reads the tracks directly.
+#ifndef SEQUENCER_UNROLLED_CYCLE
+#define SEQUENCER_UNROLLED_CYCLE 0
+#endif
 
 /**
  * @brief Simple envelope controller for ADSR triggering
@@ -82,6 +92,18 @@ public:
     uint8_t getParameterStepCount(ParamId id) const;
     void setParameterStepCount(ParamId id, uint8_t steps);
 
+    // Bulk edits on whole tracks or the whole pattern, each published at once
+    // (see ParameterManager); cheap enough to run while the sequencer plays
+    void fillTrack(ParamId id, float value);
+    void clearTrack(ParamId id);
+    void rotateTrack(ParamId id, int steps);
+    void reverseTrack(ParamId id);
+    void rotatePattern(int steps);
+    void reversePattern();
+    void transpose(int degrees); // Note track, in scale degrees
+    void copyTrackFrom(const Sequencer& other, ParamId id);
+    void copyPatternFrom(const Sequencer& other);
+
     // Sequencer control
     void start() { running = true; }
     void stop() { running = false; }
@@ -104,13 +126,16 @@ public:
      * enabling complex polyrhythmic patterns.
      *
      * Data Flow:
-     * 1. Calculate currentStepPerParam[i] = uclock_step % paramStepCount[i] for each parameter
+     * 1. Advance currentStepPerParam[i] (always song_step % paramStepCount[i]); a
+     *    step that follows the previous one just increments and wraps, a jump
+     *    or a length change recomputes the modulo
      * 2. Handle real-time parameter recording if buttons are held
      * 3. Process step using independent parameter positions
      * 4. Update VoiceState with current parameter values
      * 5. Apply AS5600 encoder modifications (done in main loop)
      *
-     * @param current_uclock_step Global step counter from UClock
+     * @param song_step Global step counter from UClock (or SampleClock); any
+     *        position, no 8-bit wrap
      * @param mm_distance Distance sensor reading (0-400mm range)
      * @param is_note_button_held Button 16 state for Note parameter recording
      * @param is_velocity_button_held Button 17 state for Velocity parameter recording
@@ -121,7 +146,7 @@ public:
      * @param current_selected_step_for_edit Selected step for editing (-1 for real-time mode)
      * @param voiceState Output voice state structure for audio synthesis
      */
-    void advanceStep(uint8_t current_uclock_step, int mm_distance,
+    void advanceStep(uint32_t song_step, int mm_distance,
                      bool is_note_button_held, bool is_velocity_button_held,
                      bool is_filter_button_held, bool is_attack_button_held,
                      bool is_decay_button_held, bool is_octave_button_held,
@@ -134,15 +159,28 @@ public:
      * This overload extracts button states from UIState and calls the main advanceStep method.
      * Provides a cleaner interface when UIState is available.
      *
-     * @param current_uclock_step Global step counter from UClock
+     * @param song_step Global step counter from UClock (or SampleClock)
      * @param mm_distance Distance sensor reading (0-400mm range)
      * @param uiState UI state containing button states and selected step
      * @param voiceState Output voice state structure for audio synthesis
   
      */
-    void advanceStep(uint8_t current_uclock_step, int mm_distance,
+    void advanceStep(uint32_t song_step, int mm_distance,
                      const UIState& uiState, VoiceState *voiceState);
 
+#if SEQUENCER_UNROLLED_CYCLE
+    static constexpr uint16_t UNROLLED_CYCLE_MAX_STEPS = 256;
+
+    /**
+     * @brief Rebuilds the unrolled cycle if the parameters changed since the
+     * last build. Call from the UI loop; the clock never waits for it.
+     */
+    void updateUnrolledCycle();
+
+    // Steps in the unrolled cycle, 0 while the table is stale or too long
+    uint16_t getUnrolledCycleLength() const;
+#endif
+
     uint8_t getCurrentStep() const { return currentStep; }
 
     /**
@@ -156,6 +194,15 @@ public:
     // Get step data
     Step getStep(uint8_t stepIdx) const;
 
+    /**
+     * @brief Packed copy of all SEQUENCER_MAX_STEPS steps for display code.
+     *
+     * Only steps whose parameters changed since the previous call are
+     * re-read, so an unchanged pattern costs a few mask checks. Call from
+     * the UI loop only: the changed-step flags have a single consumer.
+     */
+    const PackedStep* getPackedSteps() const;
+
     // State
     bool isRunning() const { return running; }
 
@@ -172,6 +219,9 @@ private:
     bool running;
     uint8_t currentStep; // Global step counter (used for Gate parameter timing)
     uint8_t currentStepPerParam[static_cast<size_t>(ParamId::Count)]; // Independent step counters for each parameter
+    uint8_t counterLength[static_cast<size_t>(ParamId::Count)];       // Track length each counter was last wrapped at
+    uint32_t lastSongStep;
+    bool countersValid;                                                // false: next advanceStep() recomputes every counter
     int8_t lastNote;
     int8_t currentNote;
     uint16_t noteDurationCounter;
@@ -180,8 +230,22 @@ private:
     bool previousStepHadSlide; // Track if previous step had slide enabled
 
 
+    mutable PackedStep packedSteps[SEQUENCER_MAX_STEPS]; // see getPackedSteps()
+
+#if SEQUENCER_UNROLLED_CYCLE
+    Step unrolledSteps[UNROLLED_CYCLE_MAX_STEPS];
+    uint16_t unrolledLength;
+    uint32_t unrolledVersion;          // ParameterManager version the table was built from
+    std::atomic<bool> unrolledValid;   // cleared while the table is rewritten
+#endif
+
     // Internal methods
+    void updateStepCounters(uint32_t songStep);
     void processStep(uint8_t stepIdx,  VoiceState* voiceState);
+    void applyStep(const Step& s, VoiceState* voiceState);
+    Step resolveCurrentStep() const;
+    static Step stepFromValues(const float (&v)[static_cast<size_t>(ParamId::Count)]);
+    void refreshPackedStep(uint8_t stepIdx) const;
 };
 
 #endif // SEQUENCER_H
@@ -2,6 +2,8 @@
 #define SEQUENCER_DEFS_H
 
 #include <stdint.h>
+#include <algorithm> // For std::min, std::fill, std::swap
+#include <cmath>     // For lroundf
 #include <variant> // Required for std::variant
 constexpr uint16_t PULSES_PER_QUARTER_NOTE = 480;
 constexpr uint8_t PULSES_PER_SEQUENCER_STEP = PULSES_PER_QUARTER_NOTE / 4;
@@ -65,22 +67,82 @@ struct StepEditButtons
     bool octave;
 };
 
-// Fixed-size parameter value array
+// Step values of a binary track (Gate, Slide), one bit per step
 template <uint8_t SIZE>
+struct BinaryValues
+{
+    uint32_t bits[(SIZE + 31) / 32];
+
+    void setRange(float /*maxValue*/) {}
+    float get(uint8_t i) const { return ((bits[i / 32] >> (i % 32)) & 1u) ? 1.0f : 0.0f; }
+    void set(uint8_t i, float value)
+    {
+        const uint32_t mask = 1u << (i % 32);
+        bits[i / 32] = (value > 0.5f) ? (bits[i / 32] | mask) : (bits[i / 32] & ~mask);
+    }
+    void fill(float value)
+    {
+        for (uint32_t &word : bits)
+        {
+            word = (value > 0.5f) ? ~0u : 0u;
+        }
+    }
+    void swap(uint8_t i, uint8_t j)
+    {
+        const float vi = get(i);
+        set(i, get(j));
+        set(j, vi);
+    }
+};
+
+// Step values of a continuous track as 16-bit fixed point. The scale is the
+// largest power of two that fits the parameter's range into 16 bits, so
+// integers (notes) and halves stay exact and reading back is one multiply
+template <uint8_t SIZE>
+struct QuantizedValues
+{
+    uint16_t q[SIZE];
+    float scale;    // steps per unit
+    float invScale; // units per step, exact for a power of two
+
+    void setRange(float maxValue)
+    {
+        scale = 1.0f;
+        while (maxValue * scale * 2.0f <= 65535.0f)
+        {
+            scale *= 2.0f;
+        }
+        invScale = 1.0f / scale;
+    }
+    float get(uint8_t i) const { return static_cast<float>(q[i]) * invScale; }
+    void set(uint8_t i, float value) { q[i] = encode(value); }
+    void fill(float value) { std::fill(q, q + SIZE, encode(value)); }
+    void swap(uint8_t i, uint8_t j) { std::swap(q[i], q[j]); }
+
+    uint16_t encode(float value) const
+    {
+        const float clamped = value < 0.0f ? 0.0f : value;
+        return static_cast<uint16_t>(std::min(lroundf(clamped * scale), 65535L));
+    }
+};
+
+// Fixed-size parameter track; Values is BinaryValues or QuantizedValues
+template <typename Values, uint8_t SIZE>
 struct ParameterTrack
 {
-    float values[SIZE];
+    Values values;
     uint8_t stepCount;
     float defaultValue;
 
-    // Initialize track with default values
-    void init(float defValue)
+    // Initialize track with default values; maxValue sizes the quantization
+    void init(float defValue, float maxValue)
     {
+        values.setRange(maxValue);
         defaultValue = defValue;
         stepCount = DEFAULT_STEPS;
         for (uint8_t i = 0; i < SIZE; ++i)
         {
-            values[i] = defValue;
+            values.set(i, defValue);
         }
     }
 
@@ -91,7 +153,7 @@ struct ParameterTrack
         {
             return defaultValue; // Prevent division by zero
         }
-        return values[stepIdx % stepCount];
+        return values.get(stepIdx % stepCount);
     }
 
     // Set value for a specific step (handles wrapping)
@@ -101,7 +163,40 @@ struct ParameterTrack
         {
             return; // Prevent division by zero
         }
-        values[stepIdx % stepCount] = value;
+        values.set(stepIdx % stepCount, value);
+    }
+
+    // Every step, including those past stepCount, to one value
+    void fill(float value) { values.fill(value); }
+
+    // Reverse the order of the active steps
+    void reverse() { reverseRange(0, stepCount); }
+
+    // Rotate the active steps; positive moves step i to i + steps
+    void rotate(int steps)
+    {
+        if (stepCount < 2)
+        {
+            return;
+        }
+        const int k = ((steps % stepCount) + stepCount) % stepCount;
+        if (k == 0)
+        {
+            return;
+        }
+        // Three reversals: in place, one swap per step
+        reverseRange(0, stepCount);
+        reverseRange(0, static_cast<uint8_t>(k));
+        reverseRange(static_cast<uint8_t>(k), stepCount);
+    }
+
+    // Add delta to every step, clamped to [minValue, maxValue]
+    void offset(float delta, float minValue, float maxValue)
+    {
+        for (uint8_t i = 0; i < SIZE; ++i)
+        {
+            values.set(i, std::max(minValue, std::min(values.get(i) + delta, maxValue)));
+        }
     }
 
     // Resize track to new step count
@@ -114,12 +209,21 @@ struct ParameterTrack
             {
                 for (uint8_t i = stepCount; i < newStepCount; ++i)
                 {
-                    values[i] = defaultValue;
+                    values.set(i, defaultValue);
                 }
             }
             stepCount = newStepCount;
         }
     }
+
+private:
+    void reverseRange(uint8_t first, uint8_t last)
+    {
+        while (last > first + 1)
+        {
+            values.swap(first++, --last);
+        }
+    }
 };
 
 // Define the variant type for parameter values that can be int, float, or bool
@@ -184,6 +288,22 @@ struct Step
     bool slide = false;
 };
 
+// Compact copy of one step for the LED and OLED code (Sequencer::getPackedSteps())
+struct PackedStep
+{
+    static constexpr uint8_t GATE = 0x01;
+    static constexpr uint8_t SLIDE = 0x02;
+
+    uint8_t flags = 0;    // GATE | SLIDE
+    uint8_t note = 0;     // Note parameter, rounded
+    uint8_t velocity = 0; // 0.0 to 1.0 as 0 to 255
+    uint8_t filter = 0;   // 0.0 to 1.0 as 0 to 255
+    int8_t octave = 0;    // -12, 0 or +12 semitones
+
+    bool gate() const { return (flags & GATE) != 0; }
+    bool slide() const { return (flags & SLIDE) != 0; }
+};
+
 // Gate timing system for automatic gate turn-off
 struct GateTimer
 {
@@ -5,6 +5,7 @@
 #include "../sequencer/Sequencer.h"
 #include "../scales/scales.h"
 #include "../sequencer/ShuffleTemplates.h"
+#include "../sequencer/SampleClock.h"
 #include "../voice/VoiceManager.h"
 #include "../LEDMatrix/LEDMatrixFeedback.h"
 #include <uClock.h>
@@ -12,6 +13,7 @@
 // External flags and helpers used by UI
 extern bool isClockRunning;
 extern Sequencer seq1, seq2, seq3, seq4;
+extern SampleClock sampleClock;
 extern void onClockStart();
 extern void onClockStop();
 extern uint8_t currentScale;
@@ -238,9 +240,11 @@ void handleControlButton(int buttonId, UIState& state) {
     case BUTTON_CHANGE_SWING_PATTERN: {
         state.currentShufflePatternIndex = (state.currentShufflePatternIndex + 1) % NUM_SHUFFLE_TEMPLATES;
         const ShuffleTemplate &currentTemplate = shuffleTemplates[state.currentShufflePatternIndex];
-        // Apply shuffle template to uClock
+        // Apply shuffle template to uClock and the sample clock (whichever runs)
         uClock.setShuffleTemplate(const_cast<int8_t *>(currentTemplate.ticks), SHUFFLE_TEMPLATE_SIZE);
         uClock.setShuffle(state.currentShufflePatternIndex > 0); // Enable shuffle if not "No Shuffle"
+        sampleClock.setShuffleTemplate(currentTemplate.ticks, SHUFFLE_TEMPLATE_SIZE);
+        sampleClock.setShuffle(state.currentShufflePatternIndex > 0);
 
         Serial.print("Shuffle pattern changed to index ");
         Serial.print(state.currentShufflePatternIndex);
@@ -0,0 +1,229 @@
+#include "AudioProfiler.h"
+
+#if AUDIO_PROFILER_COMPILED
+
+#include <atomic>
+#include <string.h>
+#if !defined(__arm__) && !defined(ARDUINO)
+#include <chrono>
+#endif
+
+namespace AudioProfiler {
+
+// Rows of the min/avg/max table: one per Stage, then the whole buffer and
+// whatever the stages did not cover (mixing, sleep checks, output conversion)
+static constexpr uint8_t ROW_BUFFER = static_cast<uint8_t>(Stage::Count);
+static constexpr uint8_t ROW_OTHER = ROW_BUFFER + 1;
+static constexpr uint8_t ROWS = ROW_OTHER + 1;
+static constexpr uint8_t SLOTS = MAX_VOICES + 1;
+static constexpr uint8_t STAGES = static_cast<uint8_t>(Stage::Count);
+
+struct Stats {
+    uint32_t buffers;
+    uint32_t minTicks[ROWS];
+    uint32_t maxTicks[ROWS];
+    uint64_t sumTicks[ROWS];
+    uint64_t voiceTicks[SLOTS][STAGES];
+    uint32_t histogram[HISTOGRAM_BINS];
+};
+
+static Stats s_stats;
+static Stats s_snapshot;
+static uint32_t s_current[SLOTS][STAGES]; // ticks booked during this buffer
+static uint32_t s_bufferStart = 0;
+static uint8_t s_voice = SHARED;
+static uint32_t s_deadlineTicks = 1;
+static uint32_t s_samplesPerBuffer = 0;
+static std::atomic<bool> s_reportRequested{false};
+static std::atomic<bool> s_resetRequested{false};
+static std::atomic<bool> s_reportReady{false};
+
+static const char* const kRowNames[ROWS] = {
+    "envelope", "source", "effects", "filter", "delay", "buffer", "other"};
+
+#if defined(__arm__)
+static constexpr uint32_t TICKS_PER_SECOND = F_CPU;
+#elif defined(ARDUINO)
+static constexpr uint32_t TICKS_PER_SECOND = 1000000u;
+uint32_t now() { return micros(); }
+#else
+static constexpr uint32_t TICKS_PER_SECOND = 1000000000u;
+uint32_t now() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+#endif
+
+void begin(uint32_t samplesPerBuffer, float sampleRate) {
+#if defined(__arm__)
+    // DEMCR.TRCENA, then DWT_CTRL.CYCCNTENA
+    *reinterpret_cast<volatile uint32_t*>(0xE000EDFCu) |= (1u << 24);
+    *reinterpret_cast<volatile uint32_t*>(0xE0001004u) = 0;
+    *reinterpret_cast<volatile uint32_t*>(0xE0001000u) |= 1u;
+#endif
+    s_samplesPerBuffer = samplesPerBuffer;
+    const uint64_t deadline = static_cast<uint64_t>(samplesPerBuffer) * TICKS_PER_SECOND /
+                              static_cast<uint64_t>(sampleRate);
+    s_deadlineTicks = deadline > 0 ? static_cast<uint32_t>(deadline) : 1;
+    reset();
+}
+
+void reset() {
+    memset(&s_stats, 0, sizeof(s_stats));
+    memset(s_current, 0, sizeof(s_current));
+    for (uint8_t r = 0; r < ROWS; r++) {
+        s_stats.minTicks[r] = UINT32_MAX;
+    }
+}
+
+void beginBuffer() {
+    s_voice = SHARED;
+    s_bufferStart = now();
+}
+
+void setVoice(uint8_t slot) { s_voice = slot < MAX_VOICES ? slot : SHARED; }
+
+uint32_t lap(Stage stage, uint32_t since) {
+    const uint32_t t = now();
+    s_current[s_voice][static_cast<uint8_t>(stage)] += t - since;
+    return t;
+}
+
+void endBuffer() {
+    const uint32_t total = now() - s_bufferStart;
+
+    uint32_t rows[ROWS] = {};
+    for (uint8_t v = 0; v < SLOTS; v++) {
+        for (uint8_t s = 0; s < STAGES; s++) {
+            rows[s] += s_current[v][s];
+            s_stats.voiceTicks[v][s] += s_current[v][s];
+            s_current[v][s] = 0;
+        }
+    }
+    uint32_t staged = 0;
+    for (uint8_t s = 0; s < STAGES; s++) {
+        staged += rows[s];
+    }
+    rows[ROW_BUFFER] = total;
+    rows[ROW_OTHER] = total > staged ? total - staged : 0;
+
+    for (uint8_t r = 0; r < ROWS; r++) {
+        if (rows[r] < s_stats.minTicks[r]) s_stats.minTicks[r] = rows[r];
+        if (rows[r] > s_stats.maxTicks[r]) s_stats.maxTicks[r] = rows[r];
+        s_stats.sumTicks[r] += rows[r];
+    }
+
+    // Exactly 100% still counts as in time; anything later is an overrun
+    uint64_t bin = static_cast<uint64_t>(total) * 10u / s_deadlineTicks;
+    if (total > s_deadlineTicks) {
+        bin = HISTOGRAM_BINS - 1;
+    } else if (bin > HISTOGRAM_BINS - 2) {
+        bin = HISTOGRAM_BINS - 2;
+    }
+    s_stats.histogram[bin]++;
+    s_stats.buffers++;
+
+    if (s_reportRequested.load(std::memory_order_acquire) && !s_reportReady.load(std::memory_order_relaxed)) {
+        s_snapshot = s_stats;
+        if (s_resetRequested.exchange(false)) {
+            reset();
+        }
+        s_reportRequested.store(false, std::memory_order_relaxed);
+        s_reportReady.store(true, std::memory_order_release);
+    }
+}
+
+static float percent(uint64_t ticks, uint32_t buffers) {
+    return buffers > 0 ? 100.0f * static_cast<float>(ticks) /
+                             (static_cast<float>(s_deadlineTicks) * static_cast<float>(buffers))
+                       : 0.0f;
+}
+
+static void printStats(const Stats& st) {
+    Serial.printf("[PROF] %lu buffers, deadline %lu us (%lu samples)\n",
+                  static_cast<unsigned long>(st.buffers),
+                  static_cast<unsigned long>(static_cast<uint64_t>(s_deadlineTicks) * 1000000u / TICKS_PER_SECOND),
+                  static_cast<unsigned long>(s_samplesPerBuffer));
+    if (st.buffers == 0) {
+        return;
+    }
+
+    Serial.printf("[PROF] %-9s %7s %7s %7s  (%% of deadline)\n", "stage", "min", "avg", "max");
+    for (uint8_t r = 0; r < ROWS; r++) {
+        Serial.printf("[PROF] %-9s %7.2f %7.2f %7.2f\n", kRowNames[r],
+                      static_cast<double>(percent(st.minTicks[r], 1)),
+                      static_cast<double>(percent(st.sumTicks[r], st.buffers)),
+                      static_cast<double>(percent(st.maxTicks[r], 1)));
+    }
+
+    Serial.printf("[PROF] %-9s", "voice");
+    for (uint8_t s = 0; s < STAGES; s++) {
+        Serial.printf(" %8s", kRowNames[s]);
+    }
+    Serial.printf("  (avg %%)\n");
+    for (uint8_t v = 0; v < SLOTS; v++) {
+        uint64_t any = 0;
+        for (uint8_t s = 0; s < STAGES; s++) {
+            any += st.voiceTicks[v][s];
+        }
+        if (any == 0) {
+            continue;
+        }
+        if (v == SHARED) {
+            Serial.printf("[PROF] %-9s", "shared");
+        } else {
+            Serial.printf("[PROF] %-9u", static_cast<unsigned>(v + 1));
+        }
+        for (uint8_t s = 0; s < STAGES; s++) {
+            Serial.printf(" %8.2f", static_cast<double>(percent(st.voiceTicks[v][s], st.buffers)));
+        }
+        Serial.printf("\n");
+    }
+
+    Serial.printf("[PROF] load histogram\n");
+    for (uint8_t b = 0; b < HISTOGRAM_BINS; b++) {
+        if (b == HISTOGRAM_BINS - 1) {
+            Serial.printf("[PROF]   overrun  %lu\n", static_cast<unsigned long>(st.histogram[b]));
+        } else {
+            Serial.printf("[PROF]   %3u-%3u%% %lu\n", static_cast<unsigned>(b * 10),
+                          static_cast<unsigned>(b * 10 + 10), static_cast<unsigned long>(st.histogram[b]));
+        }
+    }
+}
+
+void printReport() { printStats(s_stats); }
+
+void requestReport(bool resetAfter) {
+    if (resetAfter) {
+        s_resetRequested.store(true, std::memory_order_relaxed);
+    }
+    s_reportRequested.store(true, std::memory_order_release);
+}
+
+bool printRequestedReport() {
+    if (!s_reportReady.load(std::memory_order_acquire)) {
+        return false;
+    }
+    printStats(s_snapshot);
+    s_reportReady.store(false, std::memory_order_release);
+    return true;
+}
+
+} // namespace AudioProfiler
+
+#else
+// Compiled-out stubs to ensure zero code size when not compiled in
+namespace AudioProfiler {
+void begin(uint32_t, float) {}
+void reset() {}
+uint32_t now() { return 0; }
+void beginBuffer() {}
+void endBuffer() {}
+void setVoice(uint8_t) {}
+uint32_t lap(Stage, uint32_t since) { return since; }
+void printReport() {}
+void requestReport(bool) {}
+bool printRequestedReport() { return false; }
+} // namespace AudioProfiler
+#endif
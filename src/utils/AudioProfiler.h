@@ -0,0 +1,76 @@
+#pragma once
+
+// Audio-thread CPU load profiler with per-stage cycle accounting.
+// - Zero cost when compiled out via AUDIO_PROFILER_COMPILED=0 (the default):
+//   every PROF_* macro expands to nothing
+// - Times each fill_audio_buffer() call, the envelope/source/effects/filter
+//   stages of every voice and the global delay, using the Cortex-M33 DWT
+//   cycle counter on the Pico2 (steady_clock nanoseconds on the host build)
+// - Keeps min/avg/max per stage and a histogram of buffer load, all as a
+//   percentage of the buffer deadline; no dynamic allocation
+// - Written by the audio core only; other cores ask for a report with
+//   requestReport() and print it with printRequestedReport()
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifndef AUDIO_PROFILER_COMPILED
+#define AUDIO_PROFILER_COMPILED 0
+#endif
+
+namespace AudioProfiler {
+    enum class Stage : uint8_t { Envelope, Source, Effects, Filter, Delay, Count };
+
+    // Per-voice rows; work that belongs to no single voice (the global delay,
+    // the lockstep filters of the SoA engine) is booked to SHARED
+    constexpr uint8_t MAX_VOICES = 8;
+    constexpr uint8_t SHARED = MAX_VOICES;
+
+    // Buffer load histogram: 10% wide bins up to the deadline, then overruns
+    constexpr uint8_t HISTOGRAM_BINS = 11;
+
+    // Sets the deadline (one buffer of samplesPerBuffer at sampleRate),
+    // starts the cycle counter and clears the statistics
+    void begin(uint32_t samplesPerBuffer, float sampleRate);
+    void reset();
+
+#if AUDIO_PROFILER_COMPILED && defined(__arm__)
+    // DWT->CYCCNT, enabled by begin()
+    inline uint32_t now() { return *reinterpret_cast<volatile uint32_t*>(0xE0001004u); }
+#else
+    uint32_t now();
+#endif
+
+    // Audio core: bracket one buffer fill, select the voice the following
+    // laps belong to, and book the time since `since` to a stage
+    void beginBuffer();
+    void endBuffer();
+    void setVoice(uint8_t slot);
+    uint32_t lap(Stage stage, uint32_t since);
+
+    // Prints the statistics gathered so far over Serial. Only safe on the
+    // audio core or once audio has stopped (the host renderer)
+    void printReport();
+
+    // Any core: the audio core copies the statistics at the end of its next
+    // buffer (and clears them if reset is set); printRequestedReport() prints
+    // that copy once it is ready and returns true when it did
+    void requestReport(bool reset = false);
+    bool printRequestedReport();
+}
+
+#if AUDIO_PROFILER_COMPILED
+    #define PROF_BUFFER_BEGIN()  AudioProfiler::beginBuffer()
+    #define PROF_BUFFER_END()    AudioProfiler::endBuffer()
+    #define PROF_VOICE(slot)     AudioProfiler::setVoice(slot)
+    #define PROF_SHARED()        AudioProfiler::setVoice(AudioProfiler::SHARED)
+    #define PROF_START(t)        uint32_t t = AudioProfiler::now()
+    #define PROF_LAP(stage, t)   t = AudioProfiler::lap(AudioProfiler::Stage::stage, t)
+#else
+    #define PROF_BUFFER_BEGIN()  do { (void)0; } while(0)
+    #define PROF_BUFFER_END()    do { (void)0; } while(0)
+    #define PROF_VOICE(slot)     do { (void)0; } while(0)
+    #define PROF_SHARED()        do { (void)0; } while(0)
+    #define PROF_START(t)        do { (void)0; } while(0)
+    #define PROF_LAP(stage, t)   do { (void)0; } while(0)
+#endif
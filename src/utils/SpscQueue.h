@@ -0,0 +1,83 @@
+#pragma once
+
+// Wait-free single-producer/single-consumer ring buffer.
+// - One core (or thread) pushes, one other pops; neither ever blocks or spins
+// - Fixed capacity (a power of two), no dynamic allocation
+// - Elements are copied in and out whole, so a reader never sees half of an
+//   update; the release/acquire pair on the indices publishes the payload
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer: false (and nothing stored) when the queue is full. Not
+    // reentrant: an ISR pushing while the same core is inside push() loses
+    // one of the two items, so such callers must mask interrupts around it
+    bool push(const T& item) {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - headCache_ == Capacity) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (tail - headCache_ == Capacity) {
+                return false;
+            }
+        }
+        items_[tail & kMask] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false when the queue is empty
+    bool pop(T& item) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return false;
+            }
+        }
+        item = items_[head & kMask];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: the oldest element without removing it, nullptr when empty.
+    // Valid until popFront() or pop()
+    const T* front() {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (head == tailCache_) {
+                return nullptr;
+            }
+        }
+        return &items_[head & kMask];
+    }
+
+    // Consumer: removes the element front() returned
+    void popFront() {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Either side; only a snapshot while the other side is running
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint32_t kMask = Capacity - 1;
+
+    // Free-running indices; each side only writes its own and keeps a cached
+    // copy of the other's so the common case touches one shared index
+    std::atomic<uint32_t> head_{0};
+    uint32_t tailCache_ = 0;   // consumer-owned
+    std::atomic<uint32_t> tail_{0};
+    uint32_t headCache_ = 0;   // producer-owned
+    T items_[Capacity];
+};
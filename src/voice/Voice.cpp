@@ -4,9 +4,11 @@
 #include <algorithm>
 #include <cmath>
 #include "../scales/scales.h" // Use centralized SCALES_COUNT / SCALE_STEPS
+#include "../utils/AudioProfiler.h"
 
 // Constants
-static constexpr float FREQ_SLEW_RATE = 0.00035f; // Slide speed
+static constexpr float FREQ_SLEW_RATE = 0.00035f; // Slide speed (per-sample share of the remaining glide)
+static constexpr float SLIDE_SNAP = 0.001f;       // Semitones; closer than this the glide lands
 static constexpr float BASE_FREQ =
     110.0f; // Base frequency for note calculations
 
@@ -18,7 +20,7 @@ bool Voice::lookupTableInitialized = false;
 void Voice::initFrequencyLookupTable()
 {
   // Use daisysp::mtof once per MIDI note value
-  for (int midi = 0; midi < 90; ++midi)
+  for (int midi = 0; midi < 128; ++midi)
   {
     frequencyLookupTable[midi] = daisysp::mtof(static_cast<float>(midi));
   }
@@ -35,14 +37,13 @@ Voice::Voice(uint8_t id, const VoiceConfig &cfg)
     lookupTableInitialized = true;
   }
 
-  // Initialize oscillators vector
-  oscillators.resize(config.oscillatorCount);
+  // Initialize oscillator bank
+  oscillators.Init(sampleRate, config.oscillatorCount);
 
   // Initialize frequency slewing
   for (int i = 0; i < 3; i++)
   {
-    freqSlew[i].currentFreq = 440.0f;
-    freqSlew[i].targetFreq = 440.0f;
+    freqSlew[i] = VoiceSlewParams();
   }
 
   // Initialize voice state with defaults
@@ -61,19 +62,21 @@ Voice::Voice(uint8_t id, const VoiceConfig &cfg)
 void Voice::init(float sr)
 {
   sampleRate = sr;
+  sleeping = false;
 
   // Initialize oscillators
-  for (size_t i = 0; i < oscillators.size() && i < config.oscillatorCount;
-       i++)
+  oscillators.Init(sampleRate, config.oscillatorCount);
+  slideBlockSamples = std::max<uint8_t>(config.controlBlockSize, 1);
+  slideBlockDecay = daisysp::fastpowf(1.0f - FREQ_SLEW_RATE, static_cast<float>(slideBlockSamples));
+  for (size_t i = 0; i < oscillators.Count(); i++)
   {
-    oscillators[i].Init(sampleRate);
-    oscillators[i].SetWaveform(config.oscWaveforms[i]);
-    oscillators[i].SetAmp(config.oscAmplitudes[i]);
+    oscillators.SetWaveform(i, config.oscWaveforms[i]);
+    oscillators.SetAmp(i, config.oscAmplitudes[i]);
 
     // Set pulse width for square/pulse waves
     if (config.oscWaveforms[i] == daisysp::Oscillator::WAVE_POLYBLEP_SQUARE)
     {
-      oscillators[i].SetPw(config.oscPulseWidth[i]);
+      oscillators.SetPw(i, config.oscPulseWidth[i]);
     }
   }
 
@@ -84,6 +87,7 @@ void Voice::init(float sr)
 
   // Initialize particle engine
   particle_.Init(sampleRate);
+  particle_.SetSeed(voiceId);
   particle_.SetFreq(220.f);
   particle_.SetResonance(config.particleResonance);
   particle_.SetDensity(config.particleDensity);
@@ -130,23 +134,12 @@ void Voice::setConfig(const VoiceConfig &cfg)
 {
   config = cfg;
 
-  // Resize oscillators if needed
-  if (oscillators.size() != config.oscillatorCount)
-  {
-    oscillators.resize(config.oscillatorCount);
-    // Initialize new oscillators
-    for (size_t i = 0; i < oscillators.size(); i++)
-    {
-      oscillators[i].Init(sampleRate);
-    }
-  }
-
   // Update all components with new configuration
   init(sampleRate);
 }
 
 // Injected scale-data setters (defined out-of-line)
-void Voice::setScaleTable(const int (*table)[48], size_t scaleCount)
+void Voice::setScaleTable(const ScaleDegrees* table, size_t scaleCount)
 {
   scaleTable = table;
   scaleTableCount = scaleCount;
@@ -159,11 +152,11 @@ void Voice::setCurrentScalePointer(const uint8_t* ptr)
 
 float Voice::process()
 {
-  if (!config.enabled)
+  if (!config.enabled || !prepareBlock(1))
   {
     return 0.0f;
   }
-
+  PROF_START(profT);
 
   // Handle envelope retrigger
   if (state.retrigger)
@@ -176,17 +169,23 @@ float Voice::process()
  float envelopeValue = config.hasEnvelope ? envelope.Process(gate) : 1.0f;
   //float envelopeValue =  envelope.Process(gate);
 
-  // Update filter frequency with envelope modulation
-  filter.SetFreq(100.f + (filterFrequency * envelopeValue) +
-                 (filterFrequency * .1f));
+  // Control-rate update of the envelope-driven targets
+  const bool controlTick = (controlCounter == 0);
+  if (controlTick)
+  {
+    updateFilterControl(envelopeValue);
+    controlCounter = std::max<uint8_t>(config.controlBlockSize, 1);
+  }
+  controlCounter--;
+  PROF_LAP(Envelope, profT);
 
-  // Process frequency slewing for slide functionality
-  if (state.slide)
+  // Process frequency slewing for slide functionality; the oscillators
+  // ramp to each control-rate step of the glide
+  if (state.slide && controlTick)
   {
-    for (size_t i = 0; i < oscillators.size() && i < 3; i++)
+    for (size_t i = 0; i < oscillators.Count(); i++)
     {
-      processFrequencySlew(i, freqSlew[i].targetFreq);
-      oscillators[i].SetFreq(freqSlew[i].currentFreq);
+      advanceSlide(i, std::max<uint8_t>(config.controlBlockSize, 1));
     }
   }
 
@@ -195,8 +194,11 @@ float Voice::process()
 
   if (config.useParticleEngine)
   {
-  float dynamicDensity = config.particleDensity * state.velocity * envelopeValue;
-particle_.SetDensity(dynamicDensity);
+    if (controlTick)
+    {
+      float dynamicDensity = config.particleDensity * state.velocity * envelopeValue;
+      particle_.SetDensity(dynamicDensity);
+    }
     mixedOscillators = particle_.Process();
 
   }
@@ -210,38 +212,293 @@ particle_.SetDensity(dynamicDensity);
   {
     // Ring Modulation across oscillators
     mixedOscillators = 1.f;
-    for (size_t i = 0; i < oscillators.size(); i++)
+    for (size_t i = 0; i < oscillators.Count(); i++)
     {
-      mixedOscillators *= oscillators[i].Process();
+      mixedOscillators *= oscillators.Process(i);
     }
     mixedOscillators *= 3.f;
   }
   else
   {
-    for (size_t i = 0; i < oscillators.size(); i++)
+    for (size_t i = 0; i < oscillators.Count(); i++)
     {
-      mixedOscillators += oscillators[i].Process();
+      mixedOscillators += oscillators.Process(i);
     }
   }
 
+  PROF_LAP(Source, profT);
+
   // Apply effects chain
   processEffectsChain(mixedOscillators);
   mixedOscillators *= (.3f + (state.velocity));
+  PROF_LAP(Effects, profT);
   // Apply filter
   float filteredSignal = filter.Process(mixedOscillators);
 
   // Apply high-pass filter
-  highPassFilter.Process(filteredSignal);
-  float highPassedSignal = highPassFilter.High();
+  float highPassedSignal = highPassFilter.Process<daisysp::Svf::Output::High>(filteredSignal);
 
   // Apply envelope to final output
   float finalOutput = highPassedSignal * (envelopeValue) * config.outputLevel;
+  PROF_LAP(Filter, profT);
 
-
+  // Sleep is decided every MAX_BLOCK_SIZE samples, as in processBlock()
+  sleepPeak = std::max(sleepPeak, std::fabs(finalOutput));
+  if (++sleepCounter >= MAX_BLOCK_SIZE)
+  {
+    finishBlock(&sleepPeak, 1);
+    sleepPeak = 0.0f;
+    sleepCounter = 0;
+  }
 
   return finalOutput;
   }
 
+  void Voice::processBlock(float *out, size_t numSamples)
+  {
+    while (numSamples > 0)
+    {
+      const size_t n = std::min(numSamples, MAX_BLOCK_SIZE);
+      processChunk(out, n);
+      out += n;
+      numSamples -= n;
+    }
+  }
+
+  // Stage-by-stage version of process(). Every stage keeps its own state, so
+  // running each one over the whole chunk before the next gives the same
+  // samples as the interleaved per-sample path.
+  void Voice::processChunk(float *out, size_t n)
+  {
+    if (!config.enabled || !prepareBlock(n))
+    {
+      std::fill(out, out + n, 0.0f);
+      return;
+    }
+
+    float envelopeValues[MAX_BLOCK_SIZE];
+    renderSourceBlock(out, envelopeValues, n);
+
+    // Ladder filter with envelope-modulated cutoff, high-pass, envelope
+    PROF_START(profT);
+    const float outputLevel = config.outputLevel;
+    size_t pos = 0;
+    while (pos < n)
+    {
+      const size_t run = std::min(beginFilterSegment(envelopeValues[pos]), n - pos);
+      for (size_t i = pos; i < pos + run; i++)
+      {
+        out[i] = filter.Process(out[i]);
+      }
+      endFilterSegment(run);
+      pos += run;
+    }
+    // The high-pass has fixed coefficients, so it runs once over the chunk
+    highPassFilter.ProcessBlock<daisysp::Svf::Output::High>(out, n);
+    for (size_t i = 0; i < n; i++)
+    {
+      out[i] = out[i] * envelopeValues[i] * outputLevel;
+    }
+    PROF_LAP(Filter, profT);
+
+    finishBlock(out, n);
+  }
+
+  bool Voice::prepareBlock(size_t n)
+  {
+    if (sleeping && (gate || state.retrigger))
+    {
+      sleeping = false;
+    }
+    if (sleeping)
+    {
+      // Keep free-running sources in step with the voices that stayed awake;
+      // unison voices would otherwise lose their phase relationship
+      oscillators.Advance(n);
+      noise_.Advance(n);
+    }
+    return !sleeping;
+  }
+
+  void Voice::finishBlock(const float *out, size_t n)
+  {
+    if (sleeping || !canSleep())
+    {
+      return;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+      if (std::fabs(out[i]) >= SLEEP_THRESHOLD)
+      {
+        return;
+      }
+    }
+    sleeping = true;
+  }
+
+  void Voice::renderSourceBlock(float *out, float *envelopeValues, size_t n)
+  {
+    PROF_START(profT);
+    if (state.retrigger)
+    {
+      envelope.Retrigger(false);
+      state.retrigger = false;
+    }
+
+    // Envelope
+    if (config.hasEnvelope)
+    {
+      const bool gateNow = gate;
+      for (size_t i = 0; i < n; i++)
+      {
+        envelopeValues[i] = envelope.Process(gateNow);
+      }
+    }
+    else
+    {
+      std::fill(envelopeValues, envelopeValues + n, 1.0f);
+    }
+    PROF_LAP(Envelope, profT);
+
+    // Sound source
+    const size_t oscCount = oscillators.Count();
+    const size_t slewCount = state.slide ? oscCount : 0;
+
+    const uint8_t controlBlockSize = std::max<uint8_t>(config.controlBlockSize, 1);
+
+    if (config.useParticleEngine)
+    {
+      uint8_t counter = controlCounter;
+      for (size_t i = 0; i < n; i++)
+      {
+        if (counter == 0)
+        {
+          particle_.SetDensity(config.particleDensity * state.velocity * envelopeValues[i]);
+          counter = controlBlockSize;
+        }
+        counter--;
+        out[i] = particle_.Process();
+      }
+    }
+    else if (config.oscillatorCount == 0)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        out[i] = noise_.Process();
+      }
+    }
+    else
+    {
+      const bool ringMod = config.hasDalek;
+      std::fill(out, out + n, ringMod ? 1.0f : 0.0f);
+
+      for (size_t osc = 0; osc < oscCount; osc++)
+      {
+        if (osc < slewCount)
+        {
+          // Glide one control block at a time, on the same ticks as
+          // process(); the bank ramps the phase increment across each block
+          size_t left = controlCounter; // samples left of the current ramp
+          for (size_t pos = 0; pos < n;)
+          {
+            if (left == 0)
+            {
+              advanceSlide(osc, controlBlockSize);
+              left = controlBlockSize;
+            }
+            const size_t run = std::min(left, n - pos);
+            if (ringMod)
+            {
+              oscillators.ProcessMul(osc, out + pos, run);
+            }
+            else
+            {
+              oscillators.ProcessAdd(osc, out + pos, run);
+            }
+            pos += run;
+            left -= run;
+          }
+        }
+        else if (ringMod)
+        {
+          oscillators.ProcessMul(osc, out, n);
+        }
+        else
+        {
+          oscillators.ProcessAdd(osc, out, n);
+        }
+      }
+
+      if (ringMod)
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          out[i] *= 3.f;
+        }
+      }
+    }
+
+    // Slide still advances when the particle/noise engines ignore the oscillators
+    if (slewCount > 0 && (config.useParticleEngine || config.oscillatorCount == 0))
+    {
+      for (size_t osc = 0; osc < slewCount; osc++)
+      {
+        advanceSlide(osc, n);
+      }
+    }
+    PROF_LAP(Source, profT);
+
+    // Effects chain
+    if (config.hasOverdrive)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        out[i] = overdrive.Process(out[i]) * config.overdriveGain;
+      }
+    }
+    if (config.hasWavefolder)
+    {
+      for (size_t i = 0; i < n; i++)
+      {
+        out[i] = wavefolder.Process(out[i]);
+        out[i] *= config.wavefolderGain;
+      }
+    }
+
+    // Velocity
+    const float velocityGain = .3f + (state.velocity);
+    for (size_t i = 0; i < n; i++)
+    {
+      out[i] *= velocityGain;
+    }
+    PROF_LAP(Effects, profT);
+  }
+
+  size_t Voice::beginFilterSegment(float envelopeValue)
+  {
+    if (controlCounter == 0)
+    {
+      updateFilterControl(envelopeValue);
+      controlCounter = std::max<uint8_t>(config.controlBlockSize, 1);
+    }
+    return controlCounter;
+  }
+
+  void Voice::updateFilterControl(float envelopeValue)
+  {
+    // Cutoff follows the envelope; between ticks the ladder ramps its
+    // coefficients towards this target so the sweep stays smooth.
+    const float cutoff = 100.f + (filterFrequency * envelopeValue) + (filterFrequency * .1f);
+    if (config.controlBlockSize <= 1)
+    {
+      filter.SetFreq(cutoff);
+    }
+    else
+    {
+      filter.SetFreqRamped(cutoff, config.controlBlockSize);
+    }
+  }
+
   void Voice::updateParameters(const VoiceState &newState)
   {
     state = newState;
@@ -295,10 +552,12 @@ particle_.SetDensity(dynamicDensity);
       return; // Skip frequency updates when gate is LOW
     }
 
+    const int8_t octave = static_cast<int8_t>(state.octave);
+
     // Particle engine path uses a single center frequency following the base note
     if (config.useParticleEngine)
     {
-      float baseFreq = calculateNoteFrequency(state.note, state.octave, config.harmony[0]);
+      float baseFreq = calculateNoteFrequency(state.note, octave, config.harmony[0]);
       particle_.SetFreq(baseFreq);
       // Keep particle params in sync with config (in case edited live)
       particle_.SetResonance(config.particleResonance);
@@ -309,43 +568,41 @@ particle_.SetDensity(dynamicDensity);
       return;
     }
 
-    // Calculate base frequency once and cache it (used when harmony offset is 0)
-    const float baseFreq = calculateNoteFrequency(state.note, state.octave, 0);
+    // Calculate base note once and cache it (used when harmony offset is 0)
+    const int baseNote = calculateMidiNote(state.note, octave, 0);
 
     // Limit oscillator loop to max 3
-    const size_t oscCount = std::min(static_cast<size_t>(3), oscillators.size());
+    const size_t oscCount = oscillators.Count();
 
     for (size_t i = 0; i < oscCount; i++)
     {
-      // Calculate frequency for this oscillator using harmony interval
-      float harmonyFreq;
+      // Calculate note for this oscillator using harmony interval
       const int harmonyInterval = config.harmony[i];
-
-      if (harmonyInterval == 0)
-      {
-        harmonyFreq = baseFreq;
-      }
-      else
-      {
-        harmonyFreq = calculateNoteFrequency(state.note, state.octave, harmonyInterval);
-      }
+      const int harmonyNote =
+          harmonyInterval == 0 ? baseNote : calculateMidiNote(state.note, octave, harmonyInterval);
+      const float harmonyFreq = frequencyLookupTable[harmonyNote];
 
       // Apply TripleSaw-style percentage detuning relative to harmony frequency
       // fmaf(a, b, c) computes a*b + c using a single FPU instruction when available
-      const float targetFreq = std::fmaf(0.05f * config.oscDetuning[i], harmonyFreq, harmonyFreq);
+      const float detune = 0.05f * config.oscDetuning[i];
+      const float targetFreq = std::fmaf(detune, harmonyFreq, harmonyFreq);
+      const float targetPitch =
+          detune == 0.0f ? static_cast<float>(harmonyNote) : harmonyNote + 12.0f * daisysp::fastlog2f(1.0f + detune);
 
-      if (state.slide)
-      {
-        // Set target for slewing
-        freqSlew[i].targetFreq = targetFreq;
-      }
-      else
-      {
-        // Set frequency directly
-        oscillators[i].SetFreq(targetFreq);
-        freqSlew[i].currentFreq = targetFreq;
-        freqSlew[i].targetFreq = targetFreq;
-      }
+      setOscillatorTarget(i, targetFreq, targetPitch);
+    }
+  }
+
+  void Voice::setOscillatorTarget(uint8_t oscIndex, float freq, float pitch)
+  {
+    VoiceSlewParams &slew = freqSlew[oscIndex];
+    slew.targetFreq = freq;
+    slew.targetPitch = pitch;
+    if (!state.slide)
+    {
+      // Set frequency directly
+      oscillators.SetFreq(oscIndex, freq);
+      slew.currentPitch = pitch;
     }
   }
 
@@ -363,98 +620,73 @@ particle_.SetDensity(dynamicDensity);
     envelope.SetReleaseTime(release);
   }
 
-  float Voice::calculateNoteFrequency(float note, int8_t octaveOffset,
-                                      int harmony)
+  int Voice::calculateMidiNote(float note, int8_t octaveOffset, int harmony)
   {
     // Clamp note to valid range with ARM-friendly integer operations
     const int noteIndex = std::max(0, std::min(static_cast<int>(note), static_cast<int>(SCALE_STEPS - 1)));
 
-    // Resolve target index by advancing across UNIQUE scale degrees (not raw indices)
-    // This fixes pentatonic and other scales with repeated entries in the SCALE_STEPS-step table.
-    auto advanceDegrees = [](const int* row, int startIdx, int degreeOffset) -> int {
-      int idx = startIdx;
-      if (degreeOffset == 0)
-        return idx;
-
-      if (degreeOffset > 0)
-      {
-        int remaining = degreeOffset;
-        int prev = row[idx];
-        while (remaining > 0 && idx < static_cast<int>(SCALE_STEPS - 1))
-        {
-          ++idx;
-          if (row[idx] != prev)
-          {
-            --remaining;
-            prev = row[idx];
-          }
-        }
-        return idx; // clamped at SCALE_STEPS-1 if we ran out
-      }
-      else // degreeOffset < 0
-      {
-        int remaining = -degreeOffset;
-        int prev = row[idx];
-        while (remaining > 0 && idx > 0)
-        {
-          --idx;
-          if (row[idx] != prev)
-          {
-            --remaining;
-            prev = row[idx];
-          }
-        }
-        return idx; // clamped at 0 if we ran out
-      }
-    };
-
-    int harmonyNoteIndex = noteIndex;
-
-    // Resolve scale step to semitone offset using injected scale table if available
-    int scaleSemitone; // chromatic fallback will set this below
-    if (scaleTable && scaleTableCount > 0 && currentScalePtr)
+    // Resolve scale step to semitone offset using injected scale table if available.
+    // Harmony moves across UNIQUE scale degrees (not raw indices), which the
+    // precomputed degree tables resolve without walking the row.
+    int scaleSemitone;
+    if (scaleTable && scaleTableCount > 0 && currentScalePtr && *currentScalePtr < scaleTableCount)
     {
-      const uint8_t idx = *currentScalePtr;
-      if (idx < scaleTableCount)
-      {
-        const int* row = scaleTable[idx];
-        // Advance by harmony degrees across UNIQUE semitone changes in the row
-        harmonyNoteIndex = advanceDegrees(row, noteIndex, harmony);
-        // Clamp defensively (advanceDegrees already clamps but keep safe)
-        harmonyNoteIndex = std::max(0, std::min(harmonyNoteIndex, static_cast<int>(SCALE_STEPS - 1)));
-        scaleSemitone = row[harmonyNoteIndex];
-      }
-      else
-      {
-        // Invalid scale index; fall back to chromatic
-        harmonyNoteIndex = std::max(0, std::min(noteIndex + harmony, static_cast<int>(SCALE_STEPS - 1)));
-        scaleSemitone = harmonyNoteIndex;
-      }
+      scaleSemitone = scaleTable[*currentScalePtr].resolve(noteIndex, harmony);
     }
     else
     {
-      // No scale table injected; treat indices as chromatic steps
-      harmonyNoteIndex = std::max(0, std::min(noteIndex + harmony, static_cast<int>(SCALE_STEPS - 1)));
-      scaleSemitone = harmonyNoteIndex;
+      // No (valid) scale table injected; treat indices as chromatic steps
+      scaleSemitone = std::max(0, std::min(noteIndex + harmony, static_cast<int>(SCALE_STEPS - 1)));
     }
 
     // Base MIDI mapping: center around 36 as before (C2-ish) then add octave offset in semitones
     int midiNote = scaleSemitone + 36 + static_cast<int>(octaveOffset);
     // Clamp to MIDI range 0..127
-    midiNote = std::max(0, std::min(midiNote, 127));
+    return std::max(0, std::min(midiNote, 127));
+  }
 
+  float Voice::calculateNoteFrequency(float note, int8_t octaveOffset,
+                                      int harmony)
+  {
     // Fast lookup
-    return frequencyLookupTable[midiNote];
+    return frequencyLookupTable[calculateMidiNote(note, octaveOffset, harmony)];
+  }
+
+  float Voice::pitchToFrequency(float pitch)
+  {
+    pitch = std::max(0.0f, std::min(pitch, 127.0f));
+    const int i = static_cast<int>(pitch);
+    if (i >= 127)
+    {
+      return frequencyLookupTable[127];
+    }
+    const float frac = pitch - static_cast<float>(i);
+    return std::fmaf(frac, frequencyLookupTable[i + 1] - frequencyLookupTable[i], frequencyLookupTable[i]);
   }
 
-  void Voice::processFrequencySlew(uint8_t oscIndex, float targetFreq)
+  void Voice::advanceSlide(uint8_t oscIndex, size_t samples)
   {
-    if (oscIndex >= 3)
+    VoiceSlewParams &slew = freqSlew[oscIndex];
+    if (slew.currentPitch == slew.targetPitch)
+    {
       return;
+    }
 
-    // Exponential slewing for smooth frequency transitions
-    const float delta = freqSlew[oscIndex].targetFreq - freqSlew[oscIndex].currentFreq;
-    freqSlew[oscIndex].currentFreq = std::fmaf(delta, FREQ_SLEW_RATE, freqSlew[oscIndex].currentFreq);
+    // Exponential approach in pitch, FREQ_SLEW_RATE of the remaining
+    // distance per sample, taken a whole block at once
+    const float keep = samples == slideBlockSamples
+                           ? slideBlockDecay
+                           : daisysp::fastpowf(1.0f - FREQ_SLEW_RATE, static_cast<float>(samples));
+    slew.currentPitch = std::fmaf(slew.currentPitch - slew.targetPitch, keep, slew.targetPitch);
+    if (std::fabs(slew.currentPitch - slew.targetPitch) < SLIDE_SNAP)
+    {
+      slew.currentPitch = slew.targetPitch;
+      oscillators.SetFreqRamped(oscIndex, slew.targetFreq, samples);
+    }
+    else
+    {
+      oscillators.SetFreqRamped(oscIndex, pitchToFrequency(slew.currentPitch), samples);
+    }
   }
 
   void Voice::setFrequency(float frequency)
@@ -467,7 +699,7 @@ particle_.SetDensity(dynamicDensity);
     }
 
     // Set the base frequency for all oscillators with TripleSaw-style percentage detuning
-    for (uint8_t i = 0; i < config.oscillatorCount && i < oscillators.size() && i < 3; i++)
+    for (uint8_t i = 0; i < config.oscillatorCount && i < oscillators.Count(); i++)
     {
       float targetFreq;
 
@@ -476,18 +708,9 @@ particle_.SetDensity(dynamicDensity);
       // Positive values detune up, negative values detune down
       targetFreq = frequency + (0.05f * frequency * config.oscDetuning[i]);
 
-      if (state.slide)
-      {
-        // Set target for slewing (slide functionality)
-        freqSlew[i].targetFreq = targetFreq;
-      }
-      else
-      {
-        // Set frequency directly
-        oscillators[i].SetFreq(targetFreq);
-        freqSlew[i].currentFreq = targetFreq;
-        freqSlew[i].targetFreq = targetFreq;
-      }
+      // Fractional MIDI note of the target, for the pitch-domain slide
+      const float targetPitch = 69.0f + 12.0f * daisysp::fastlog2f(std::max(targetFreq, 1.0f) / 440.0f);
+      setOscillatorTarget(i, targetFreq, targetPitch);
     }
   }
 
@@ -513,7 +736,7 @@ particle_.SetDensity(dynamicDensity);
       config.oscAmplitudes[1] = .3f;
       config.oscAmplitudes[2] = .3f;
       config.oscDetuning[0] = 0.0f;
-      config.oscDetuning[1] = 0.02;   // Slight detune
+      config.oscDetuning[1] = 0.02f;  // Slight detune
       config.oscDetuning[2] = -0.02f; // Slight detune opposite`
       config.harmony[0] = 0;          // Root note
       config.harmony[1] = 0;          // Unison (no harmony)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../dsp/oscillator.h"
+#include "../dsp/oscillator_bank.h"
 #include "../dsp/ladder.h"
 #include "../dsp/svf.h"
 #include "../dsp/adsr.h"
@@ -16,6 +17,8 @@
 #include <cstddef>
 #include <cstdint>
 
+struct ScaleDegrees; // scales.h
+
 /**
  * @brief Configuration structure for a voice
  * Defines the characteristics and behavior of a synthesizer voice
@@ -68,6 +71,11 @@ float overdriveGain =.34f;
     float defaultSustain = 0.5f;
     float defaultRelease = 0.1f;
 
+    // Control-rate modulation: envelope-driven targets (filter cutoff, particle
+    // density) are recomputed every controlBlockSize samples and the filter
+    // coefficients ramp linearly in between. 1 = update every sample.
+    uint8_t controlBlockSize = 16;
+
     // Voice mixing
     float outputLevel = .6f;
     bool enabled = true;
@@ -75,10 +83,14 @@ float overdriveGain =.34f;
 
 /**
  * @brief Frequency slewing parameters for smooth slide transitions
+ *
+ * The glide runs in pitch (fractional MIDI note) so it is exponential in
+ * frequency: every octave takes the same time.
  */
 struct VoiceSlewParams {
-    float currentFreq = 440.0f;
-    float targetFreq = 440.0f;
+    float currentPitch = 69.0f;  // Where the glide is now
+    float targetPitch = 69.0f;   // Where it is heading
+    float targetFreq = 440.0f;   // Exact frequency at targetPitch, set on arrival
 };
 
 /**
@@ -140,6 +152,96 @@ public:
      */
     float process();
 
+    /**
+     * @brief Largest number of samples rendered in one internal pass of processBlock()
+     *
+     * Longer requests are split into chunks of this size; it also bounds the
+     * scratch buffers callers keep on the stack.
+     */
+    static constexpr size_t MAX_BLOCK_SIZE = 64;
+
+    /**
+     * @brief Render a block of samples into a caller-supplied buffer
+     *
+     * Produces the same samples as calling process() numSamples times, but the
+     * VoiceConfig branches and state reads are resolved once per block and
+     * each processing stage runs as its own tight loop over the block.
+     *
+     * @param out Destination buffer (overwritten, numSamples long)
+     * @param numSamples Number of samples to render
+     */
+    void processBlock(float* out, size_t numSamples);
+
+    // Staged block rendering. processBlock() is built from these; VoiceManager's
+    // structure-of-arrays engine (VOICE_SOA_ENGINE) calls them directly so it can
+    // run the filters of all voices in lockstep.
+
+    /**
+     * @brief Render envelope, sound source, effects and velocity for one chunk
+     * @param out Pre-filter signal (numSamples long, at most MAX_BLOCK_SIZE)
+     * @param envelope Envelope values for the same samples
+     * @param numSamples Number of samples to render
+     */
+    void renderSourceBlock(float* out, float* envelope, size_t numSamples);
+
+    /**
+     * @brief Run the control-rate filter update if one is due
+     * @param envelopeValue Envelope value at the current sample
+     * @return size_t Samples the filter can run before the next control tick
+     */
+    size_t beginFilterSegment(float envelopeValue);
+
+    /**
+     * @brief Account for samples run through the filters since beginFilterSegment()
+     * @param samples Number of samples processed, at most the value it returned
+     */
+    void endFilterSegment(size_t samples) { controlCounter -= static_cast<uint8_t>(samples); }
+
+    /**
+     * @brief Output level below which a finished voice may fall asleep (-100 dB)
+     */
+    static constexpr float SLEEP_THRESHOLD = 1e-5f;
+
+    /**
+     * @brief Check whether the voice is asleep
+     *
+     * A voice falls asleep at the end of a MAX_BLOCK_SIZE block once its
+     * envelope is idle, the gate is low and the block's output stayed below
+     * SLEEP_THRESHOLD. While asleep process() and processBlock() return
+     * silence without running any DSP; the next gate or retrigger wakes it.
+     * Voices without an envelope never sleep.
+     */
+    bool isSleeping() const { return sleeping; }
+
+    /**
+     * @brief Wake the voice if it has been gated and report whether it renders
+     *
+     * While asleep the oscillator phases and noise generator are still
+     * advanced by numSamples, so they are where they would have been on waking.
+     *
+     * @param numSamples Length of the coming block
+     * @return bool True if the block has to be rendered, false while asleep
+     */
+    bool prepareBlock(size_t numSamples);
+
+    /**
+     * @brief Put the voice to sleep if the block just rendered allows it
+     * @param out Final voice output of the block
+     * @param numSamples Number of samples in the block
+     */
+    void finishBlock(const float* out, size_t numSamples);
+
+    /**
+     * @brief Access the ladder filter (for lockstep processing across voices)
+     */
+    daisysp::LadderFilter& getFilter() { return filter; }
+
+    /**
+     * @brief Access the high-pass filter (for lockstep processing across voices)
+     */
+    daisysp::Svf& getHighPassFilter() { return highPassFilter; }
+
+
     /**
      * @brief Update voice parameters from sequencer state
      * @param newState New voice state from sequencer
@@ -160,14 +262,14 @@ public:
     void setSequencer(Sequencer* seq);
 
     /**
-     * @brief Inject scale data (48-step per-scale tables) to remove global dependencies
-     * @param table Pointer to a 2D array of shape [scaleCount][48]
+     * @brief Inject scale data (per-scale degree tables) to remove global dependencies
+     * @param table Pointer to an array of scaleCount ScaleDegrees (see scales.h)
      * @param scaleCount Number of scales available in the table
      *
-     * The Voice will use this table to map scale step indices (0..47) to semitone offsets.
-     * Pass nullptr to disable and fall back to chromatic mapping.
+     * The Voice will use this table to map scale step indices (0..47) plus harmony
+     * degrees to semitone offsets. Pass nullptr to disable and fall back to chromatic mapping.
      */
-    void setScaleTable(const int (*table)[48], size_t scaleCount);
+    void setScaleTable(const ScaleDegrees* table, size_t scaleCount);
 
     /**
      * @brief Inject a pointer to the current scale index used with the injected table
@@ -260,18 +362,19 @@ private:
     float sampleRate;
 
     // Frequency lookup table for performance optimization
-    // Covers all possible MIDI notes (0-127) to avoid mtof() calculations
+    // Covers all possible MIDI notes (0-127) to avoid mtof() calculations;
+    // pitchToFrequency() interpolates it for fractional notes
     static float frequencyLookupTable[128];
     static bool lookupTableInitialized;
 
     // Injected scale data (optional). When null, Voice uses chromatic mapping.
-    // scaleTable is a pointer to an array of 48-step scales; scaleTableCount is number of scales.
-    const int (*scaleTable)[48] = nullptr;
+    // scaleTable points to one ScaleDegrees per scale; scaleTableCount is number of scales.
+    const ScaleDegrees* scaleTable = nullptr;
     size_t scaleTableCount = 0;
     const uint8_t* currentScalePtr = nullptr; // Pointer to externally managed current-scale index
 
     // Audio processing components
-    std::vector<daisysp::Oscillator> oscillators;
+    daisysp::OscillatorBank oscillators;
     daisysp::WhiteNoise noise_;
     daisysp::Particle particle_;
     daisysp::LadderFilter filter;
@@ -284,7 +387,15 @@ private:
     VoiceState state;
     float filterFrequency;
     VoiceSlewParams freqSlew[3]; // For slide functionality
+    float slideBlockDecay = 1.0f;  // Glide distance kept after one control block
+    uint8_t slideBlockSamples = 0; // Control block slideBlockDecay was computed for
     volatile bool gate;
+    uint8_t controlCounter = 0;  // Samples until the next control-rate update
+
+    // Voice sleep (see isSleeping())
+    bool sleeping = false;
+    float sleepPeak = 0.0f;      // process(): peak output of the current block
+    uint8_t sleepCounter = 0;    // process(): samples into the current block
 
     // Sequencer (non-owning pointer)
     Sequencer* sequencer;
@@ -296,6 +407,24 @@ private:
      */
     void processEffectsChain(float& signal);
 
+    /**
+     * @brief True when nothing but a gate or retrigger can make the voice audible again
+     */
+    bool canSleep() const { return config.hasEnvelope && !gate && !state.retrigger && !envelope.IsRunning(); }
+
+    /**
+     * @brief Render up to MAX_BLOCK_SIZE samples (processBlock() worker)
+     * @param out Destination buffer
+     * @param numSamples Number of samples, at most MAX_BLOCK_SIZE
+     */
+    void processChunk(float* out, size_t numSamples);
+
+    /**
+     * @brief Recompute the envelope-driven filter cutoff target
+     * @param envelopeValue Envelope output at the control tick
+     */
+    void updateFilterControl(float envelopeValue);
+
     /**
      * @brief Update oscillator frequencies based on current state
      */
@@ -307,11 +436,17 @@ private:
     void applyEnvelopeParameters();
 
     /**
-     * @brief Calculate frequency for a given note with octave offset
+     * @brief Calculate MIDI note for a given note with octave offset
      * @param note Note value (0-21 for scale array lookup)
      * @param octaveOffset Octave offset in semitones
      * @param harmony Harmony value
-     * @return float Frequency in Hz
+     * @return int MIDI note, 0-127
+     */
+    int calculateMidiNote(float note, int8_t octaveOffset, int harmony);
+
+    /**
+     * @brief Calculate frequency for a given note with octave offset
+     * @return float Frequency in Hz (see calculateMidiNote)
      */
     float calculateNoteFrequency(float note, int8_t octaveOffset, int harmony);
 
@@ -319,11 +454,24 @@ private:
     static void initFrequencyLookupTable();
 
     /**
-     * @brief Process frequency slewing for slide functionality
+     * @brief Frequency of a fractional MIDI note, interpolated from the lookup table
+     */
+    static float pitchToFrequency(float pitch);
+
+    /**
+     * @brief Set where oscillator oscIndex plays next: at once, or as a slide target
+     * @param oscIndex Oscillator index (0-2)
+     * @param freq Target frequency in Hz
+     * @param pitch The same target as a fractional MIDI note
+     */
+    void setOscillatorTarget(uint8_t oscIndex, float freq, float pitch);
+
+    /**
+     * @brief Advance the slide of one oscillator by a control block
      * @param oscIndex Oscillator index (0-2)
-     * @param targetFreq Target frequency for slewing
+     * @param samples Block length; the oscillator ramps to the new pitch over it
      */
-    void processFrequencySlew(uint8_t oscIndex, float targetFreq);
+    void advanceSlide(uint8_t oscIndex, size_t samples);
 };
 
 /**
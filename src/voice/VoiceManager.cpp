@@ -2,7 +2,9 @@
 #include <algorithm>
 #include <cstring>
 #include "../utils/Debug.h"
+#include "../utils/AudioProfiler.h"
 #include "../scales/scales.h" // Inject scale data into voices
+#include "pico/sync.h"         // save_and_disable_interrupts()
 
 /**
  * Constructor for VoiceManager
@@ -13,7 +15,8 @@
  * Pre-allocates vector capacity to avoid runtime allocations on embedded systems
  */
 VoiceManager::VoiceManager(uint8_t maxVoices)
-    : maxVoiceCount(maxVoices), nextVoiceId(1), sampleRate(48000.0f), globalVolume(1.0f) {
+    : maxVoiceCount(maxVoices), nextVoiceId(1), sampleRate(48000.0f), globalVolume(1.0f), droppedCommands(0),
+      lastQueuedWhen(0), sampleTime(0), eventTiming{} {
     voices.reserve(maxVoiceCount);
     DBG_INFO("VoiceManager: constructed maxVoices=%u", maxVoices);
 }
@@ -38,7 +41,7 @@ uint8_t VoiceManager::addVoice(const VoiceConfig& config) {
     auto voice = std::make_unique<Voice>(voiceId, config);
 
     // Inject scale context to avoid global coupling inside Voice
-    voice->setScaleTable(scale, SCALES_COUNT);
+    voice->setScaleTable(scaleDegrees.data(), SCALES_COUNT);
     voice->setCurrentScalePointer(&currentScale);
 
     voice->init(sampleRate);
@@ -169,15 +172,26 @@ VoiceConfig* VoiceManager::getVoiceConfig(uint8_t voiceId) {
  *
  * @param voiceId Voice to update
  * @param state VoiceState structure containing frequency, gate, velocity, etc.
- * @return bool True if voice found and updated, false otherwise
+ * @param atSample Sample time (getSampleTime() timeline) the update takes effect at
+ * @return bool True if voice found and the update was queued, false otherwise
  *
- * Immediately applies new state to voice, triggers note on/off, pitch changes
+ * Queues the new state for the audio core, which applies it (note on/off,
+ * pitch changes) on sample atSample, or at the start of its next block if
+ * that has already passed
  * Notifies registered callbacks about the voice update
  */
-bool VoiceManager::updateVoiceState(uint8_t voiceId, const VoiceState& state) {
+bool VoiceManager::updateVoiceState(uint8_t voiceId, const VoiceState& state, uint32_t atSample) {
     ManagedVoice* managedVoice = findVoice(voiceId);
     if (managedVoice && managedVoice->voice) {
-        managedVoice->voice->updateParameters(state);
+        VoiceCommand command;
+        command.type = VoiceCommand::Type::State;
+        command.voiceId = voiceId;
+        command.when = atSample;
+        command.value = 0.0f;
+        command.state = state;
+        if (!postCommand(command)) {
+            return false;
+        }
         // Verbose-level to avoid flooding unless explicitly enabled
         DBG_VERBOSE("VoiceManager: updateVoiceState id=%u note=%.1f vel=%.2f gate=%d filt=%.2f", voiceId, state.note, state.velocity, state.gate ? 1 : 0, state.filter);
         notifyVoiceUpdated(voiceId, state);
@@ -187,6 +201,99 @@ bool VoiceManager::updateVoiceState(uint8_t voiceId, const VoiceState& state) {
     return false;
 }
 
+/**
+ * Queues a command for the audio core
+ *
+ * @param command Command to queue
+ * @return bool True if queued, false if the queue was full (the command is dropped)
+ *
+ * Wait-free: never blocks the control core, counts drops instead
+ *
+ * The command queue has a single producer, core1, but both the uClock ISR
+ * (step updates) and loop1() (UI edits) post from it. Core1's interrupts
+ * are masked around the push so the ISR cannot fill the slot loop1() is
+ * about to publish. Never call from core0.
+ *
+ * The queue is applied strictly in order, so a command stamped earlier than
+ * one already queued (a UI edit stamped "now" behind a step stamped a buffer
+ * ahead) is restamped to that later time: it is applied on the sample it can
+ * actually take effect, and not counted as late.
+ */
+bool VoiceManager::postCommand(const VoiceCommand& command) {
+    VoiceCommand stamped = command;
+    // The restamp and drop count are read-modify-writes too, so they share
+    // the masked section with the push: otherwise a UI post interrupted by a
+    // step could write back a stale lastQueuedWhen after it
+    const uint32_t irqs = save_and_disable_interrupts();
+    // Signed differences so the comparisons survive the 32-bit wrap; a
+    // lastQueuedWhen already in the past is stale and never holds anything back
+    if (static_cast<int32_t>(lastQueuedWhen - stamped.when) > 0 &&
+        static_cast<int32_t>(lastQueuedWhen - getSampleTime()) > 0) {
+        stamped.when = lastQueuedWhen;
+    }
+    const bool queued = commands.push(stamped);
+    if (queued) {
+        lastQueuedWhen = stamped.when;
+    } else {
+        droppedCommands++;
+    }
+    restore_interrupts(irqs);
+    if (!queued) {
+        DBG_WARN("VoiceManager: command queue full, dropped command for id=%u", command.voiceId);
+    }
+    return queued;
+}
+
+/**
+ * Applies the queued voice commands that are due at the current sample time
+ * Called by the audio core before rendering each run of samples
+ *
+ * @param maxSamples Largest run the caller wants to render
+ * @return size_t Samples to render before the next queued command is due (1..maxSamples)
+ *
+ * Voices only ever change between runs, so a run never renders a
+ * half-written VoiceState or a frequency from one update with the gate
+ * of another. Commands whose time has passed are applied now and counted
+ * as late in the event timing stats.
+ */
+size_t VoiceManager::processCommands(size_t maxSamples) {
+    const uint32_t now = sampleTime.load(std::memory_order_relaxed);
+    while (const VoiceCommand* command = commands.front()) {
+        // Signed difference so the comparison survives the 32-bit wrap
+        const int32_t due = static_cast<int32_t>(command->when - now);
+        if (due > 0) {
+            return std::min(maxSamples, static_cast<size_t>(due));
+        }
+        const uint32_t delay = static_cast<uint32_t>(-due);
+        eventTiming.events++;
+        eventTiming.totalDelay += delay;
+        if (delay > 0) {
+            eventTiming.late++;
+            eventTiming.maxDelay = std::max(eventTiming.maxDelay, delay);
+        }
+        applyCommand(*command);
+        commands.popFront();
+    }
+    return maxSamples;
+}
+
+void VoiceManager::applyCommand(const VoiceCommand& command) {
+    ManagedVoice* managedVoice = findVoice(command.voiceId);
+    if (managedVoice && managedVoice->voice) {
+        switch (command.type) {
+            case VoiceCommand::Type::State:
+                managedVoice->voice->updateParameters(command.state);
+                break;
+            case VoiceCommand::Type::Frequency:
+                managedVoice->voice->setFrequency(command.value);
+                break;
+            case VoiceCommand::Type::Slide:
+                managedVoice->voice->setSlideTime(command.value);
+                break;
+        }
+    }
+}
+
 /**
  * Retrieves the current real-time state of a voice
  * Provides access to live parameters like current frequency, gate status, velocity
@@ -294,18 +401,164 @@ void VoiceManager::init(float sr) {
  * Optimized for embedded systems with minimal branching
  */
 float VoiceManager::processAllVoices() {
+    processCommands(1);
     float mixedOutput = 0.0f;
 
-    for (auto& managedVoice : voices) {
+    for (size_t slot = 0; slot < voices.size(); ++slot) {
+        auto& managedVoice = voices[slot];
         if (managedVoice->enabled && managedVoice->voice) {
+            PROF_VOICE(slot);
             float voiceOutput = managedVoice->voice->process();
             mixedOutput += voiceOutput * managedVoice->mixLevel;
         }
     }
 
+    sampleTime.store(sampleTime.load(std::memory_order_relaxed) + 1, std::memory_order_release);
     return mixedOutput * globalVolume;
 }
 
+/**
+ * Block version of processAllVoices()
+ * Renders each enabled voice a block at a time and mixes it into the output
+ *
+ * @param out Destination buffer, overwritten with numSamples mixed samples
+ * @param numSamples Number of samples to render
+ *
+ * Produces the same samples as numSamples calls to processAllVoices(), but
+ * voice dispatch, enable checks and mix levels are handled once per block
+ * (Voice::MAX_BLOCK_SIZE samples) instead of once per sample. Blocks are
+ * cut short where a queued command is due, so it lands on its exact sample.
+ */
+void VoiceManager::processAllVoicesBlock(float* out, size_t numSamples) {
+    while (numSamples > 0) {
+        const size_t n = processCommands(std::min(numSamples, Voice::MAX_BLOCK_SIZE));
+        renderBlock(out, n);
+        sampleTime.store(sampleTime.load(std::memory_order_relaxed) + static_cast<uint32_t>(n),
+                         std::memory_order_release);
+        out += n;
+        numSamples -= n;
+    }
+}
+
+/**
+ * Renders and mixes one block of at most Voice::MAX_BLOCK_SIZE samples
+ *
+ * @param out Destination buffer, overwritten with n mixed samples
+ * @param n Number of samples to render
+ */
+void VoiceManager::renderBlock(float* out, size_t n) {
+#if VOICE_SOA_ENGINE
+    // Structure-of-arrays engine: sources run per voice, then the filters of
+    // all active voices advance together one control segment at a time.
+    float laneBuffers[daisysp::LadderFilter::kMaxLanes][Voice::MAX_BLOCK_SIZE];
+    float laneEnvelopes[daisysp::LadderFilter::kMaxLanes][Voice::MAX_BLOCK_SIZE];
+    Voice* laneVoices[daisysp::LadderFilter::kMaxLanes];
+    uint8_t laneSlots[daisysp::LadderFilter::kMaxLanes];
+    float laneMix[daisysp::LadderFilter::kMaxLanes];
+    daisysp::LadderFilter* ladders[daisysp::LadderFilter::kMaxLanes];
+    daisysp::Svf* highPasses[daisysp::LadderFilter::kMaxLanes];
+    float* segmentBuffers[daisysp::LadderFilter::kMaxLanes];
+
+    // Sleeping voices take no lane. Once every lane is taken the remaining
+    // slots render voice by voice below; they are not prepared here, as
+    // prepareBlock() advances a sleeping voice's sources
+    size_t lanes = 0;
+    size_t overflowSlot = voices.size();
+    for (size_t slot = 0; slot < voices.size(); ++slot) {
+        if (lanes == daisysp::LadderFilter::kMaxLanes) {
+            overflowSlot = slot;
+            break;
+        }
+        auto& managedVoice = voices[slot];
+        Voice* voice = managedVoice->voice.get();
+        if (managedVoice->enabled && voice && voice->isEnabled() && voice->prepareBlock(n)) {
+            laneVoices[lanes] = voice;
+            laneSlots[lanes] = static_cast<uint8_t>(slot);
+            laneMix[lanes] = managedVoice->mixLevel;
+            ladders[lanes] = &voice->getFilter();
+            highPasses[lanes] = &voice->getHighPassFilter();
+            lanes++;
+        }
+    }
+    if (lanes == 0) {
+        std::fill(out, out + n, 0.0f);
+        return;
+    }
+
+    for (size_t l = 0; l < lanes; ++l) {
+        PROF_VOICE(laneSlots[l]);
+        laneVoices[l]->renderSourceBlock(laneBuffers[l], laneEnvelopes[l], n);
+    }
+
+    // The lockstep filters cannot be split per voice; book them as shared
+    PROF_SHARED();
+    PROF_START(profT);
+    size_t pos = 0;
+    while (pos < n) {
+        size_t run = n - pos;
+        for (size_t l = 0; l < lanes; ++l) {
+            run = std::min(run, laneVoices[l]->beginFilterSegment(laneEnvelopes[l][pos]));
+            segmentBuffers[l] = laneBuffers[l] + pos;
+        }
+        daisysp::LadderFilter::ProcessLanes(ladders, segmentBuffers, lanes, run);
+        for (size_t l = 0; l < lanes; ++l) {
+            laneVoices[l]->endFilterSegment(run);
+        }
+        pos += run;
+    }
+
+    for (size_t l = 0; l < lanes; ++l) {
+        segmentBuffers[l] = laneBuffers[l];
+    }
+    daisysp::Svf::ProcessHighLanes(highPasses, segmentBuffers, lanes, n);
+    PROF_LAP(Filter, profT);
+
+    std::fill(out, out + n, 0.0f);
+    for (size_t l = 0; l < lanes; ++l) {
+        float* voiceOut = laneBuffers[l];
+        const float outputLevel = laneVoices[l]->getConfig().outputLevel;
+        const float mixLevel = laneMix[l];
+        for (size_t i = 0; i < n; ++i) {
+            voiceOut[i] = voiceOut[i] * laneEnvelopes[l][i] * outputLevel;
+            out[i] += voiceOut[i] * mixLevel;
+        }
+        laneVoices[l]->finishBlock(voiceOut, n);
+    }
+
+    float* voiceBlock = laneBuffers[0];
+    for (size_t slot = overflowSlot; slot < voices.size(); ++slot) {
+        auto& managedVoice = voices[slot];
+        if (managedVoice->enabled && managedVoice->voice) {
+            PROF_VOICE(slot);
+            managedVoice->voice->processBlock(voiceBlock, n);
+            const float mixLevel = managedVoice->mixLevel;
+            for (size_t i = 0; i < n; ++i) {
+                out[i] += voiceBlock[i] * mixLevel;
+            }
+        }
+    }
+#else
+    float voiceBlock[Voice::MAX_BLOCK_SIZE];
+    std::fill(out, out + n, 0.0f);
+
+    for (size_t slot = 0; slot < voices.size(); ++slot) {
+        auto& managedVoice = voices[slot];
+        if (managedVoice->enabled && managedVoice->voice) {
+            PROF_VOICE(slot);
+            managedVoice->voice->processBlock(voiceBlock, n);
+            const float mixLevel = managedVoice->mixLevel;
+            for (size_t i = 0; i < n; ++i) {
+                out[i] += voiceBlock[i] * mixLevel;
+            }
+        }
+    }
+#endif
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] *= globalVolume;
+    }
+}
+
 /**
  * Processes a single voice and returns its output
  * Individual voice processing for solo monitoring or per-voice effects
@@ -370,6 +623,25 @@ bool VoiceManager::isVoiceEnabled(uint8_t voiceId) const {
     return managedVoice ? managedVoice->enabled : false;
 }
 
+/**
+ * Counts enabled voices that are currently rendering
+ *
+ * @return Number of enabled voices that are not asleep (see Voice::isSleeping())
+ *
+ * Compare with getActiveVoiceIds().size() to see how many voices the sleep
+ * logic is saving.
+ */
+uint8_t VoiceManager::getAwakeVoiceCount() const {
+    uint8_t count = 0;
+    for (const auto& managedVoice : voices) {
+        if (managedVoice->enabled && managedVoice->voice && managedVoice->voice->isEnabled() &&
+            !managedVoice->voice->isSleeping()) {
+            count++;
+        }
+    }
+    return count;
+}
+
 /**
  * Returns list of all currently enabled voice IDs
  *
@@ -397,8 +669,9 @@ std::vector<uint8_t> VoiceManager::getActiveVoiceIds() const {
  *
  * @return size_t Total bytes allocated for VoiceManager and all managed voices
  *
- * Includes: manager object, voice vector, all ManagedVoice instances,
- * Voice objects, and their DSP components (oscillators, filters, envelopes)
+ * Includes: manager object, voice vector, all ManagedVoice instances and
+ * Voice objects, whose DSP components (oscillators, filters, envelope) are
+ * members held by value
  * Useful for memory profiling and embedded system resource monitoring
  */
 size_t VoiceManager::getMemoryUsage() const {
@@ -410,12 +683,8 @@ size_t VoiceManager::getMemoryUsage() const {
     for (const auto& managedVoice : voices) {
         totalSize += sizeof(ManagedVoice);
         if (managedVoice->voice) {
+            // Oscillators, filters and envelope are held by value
             totalSize += sizeof(Voice);
-            // Add approximate size of voice components
-            totalSize += managedVoice->voice->getConfig().oscillatorCount * sizeof(daisysp::Oscillator);
-            totalSize += sizeof(daisysp::LadderFilter); // Filter
-            totalSize += sizeof(daisysp::Svf);        // High-pass filter
-            totalSize += sizeof(daisysp::Adsr);       // Envelope
         }
     }
 
@@ -561,6 +830,15 @@ VoiceManager::ManagedVoice* VoiceManager::findVoice(uint8_t voiceId) {
     return nullptr;
 }
 
+const VoiceManager::ManagedVoice* VoiceManager::findVoice(uint8_t voiceId) const {
+    for (const auto& voice : voices) {
+        if (voice->id == voiceId) {
+            return voice.get();
+        }
+    }
+    return nullptr;
+}
+
 /**
  * Private helper: generates unique voice IDs
  *
@@ -649,16 +927,24 @@ void VoiceManager::setVoiceVolume(uint8_t voiceId, float volume) {
  *
  * @param voiceId Voice to control
  * @param frequency Frequency in Hz (e.g., 440.0f for A4)
+ * @param atSample Sample time the change takes effect at
+ * @return bool True if voice found and the change was queued
  *
- * Immediately updates voice oscillators to new frequency
+ * Queued like updateVoiceState(); the oscillators follow on sample atSample
  * Used for MIDI note input, pitch bend, or manual tuning
  */
-void VoiceManager::setVoiceFrequency(uint8_t voiceId, float frequency) {
+bool VoiceManager::setVoiceFrequency(uint8_t voiceId, float frequency, uint32_t atSample) {
     ManagedVoice* managedVoice = findVoice(voiceId);
     if (managedVoice && managedVoice->voice) {
-        managedVoice->voice->setFrequency(frequency);
+        VoiceCommand command;
+        command.type = VoiceCommand::Type::Frequency;
+        command.voiceId = voiceId;
+        command.when = atSample;
+        command.value = frequency;
         DBG_VERBOSE("VoiceManager: setVoiceFrequency id=%u f=%.2f", voiceId, frequency);
+        return postCommand(command);
     }
+    return false;
 }
 
 /**
@@ -667,15 +953,22 @@ void VoiceManager::setVoiceFrequency(uint8_t voiceId, float frequency) {
  *
  * @param voiceId Voice to control
  * @param slideTime Slide time in seconds (0.0 = instant, higher = slower glide)
+ * @param atSample Sample time the change takes effect at
+ * @return bool True if voice found and the change was queued
  *
  * Enables smooth pitch transitions between notes
  * Applied to frequency parameter changes for legato playing
  */
-void VoiceManager::setVoiceSlide(uint8_t voiceId, float slideTime) {
+bool VoiceManager::setVoiceSlide(uint8_t voiceId, float slideTime, uint32_t atSample) {
+    DBG_VERBOSE("VoiceManager: setVoiceSlide id=%u t=%.3f", voiceId, slideTime);
     ManagedVoice* managedVoice = findVoice(voiceId);
     if (managedVoice && managedVoice->voice) {
-        managedVoice->voice->setSlideTime(slideTime);
+        VoiceCommand command;
+        command.type = VoiceCommand::Type::Slide;
+        command.voiceId = voiceId;
+        command.when = atSample;
+        command.value = slideTime;
+        return postCommand(command);
     }
-    DBG_VERBOSE("VoiceManager: setVoiceSlide id=%u t=%.3f", voiceId, slideTime);
-
+    return false;
 }
\ No newline at end of file
@@ -2,10 +2,20 @@
 
 #include "Voice.h"
 #include "../sequencer/Sequencer.h"
+#include "../utils/SpscQueue.h"
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <functional>
 
+// Build-time engine selection. 1 renders the ladder and high-pass filters of all
+// voices in lockstep structure-of-arrays loops (LadderFilter::ProcessLanes,
+// Svf::ProcessHighLanes) instead of voice by voice in processAllVoicesBlock().
+// Only affects the block path (VOICE_BLOCK_PROCESSING in the sketch).
+#ifndef VOICE_SOA_ENGINE
+#define VOICE_SOA_ENGINE 0
+#endif
+
 /**
  * VoiceManager - Manages multiple voices for polyphonic/multitimbral synthesis
  * 
@@ -39,7 +49,14 @@ public:
     VoiceConfig* getVoiceConfig(uint8_t voiceId);
     
     // Voice State Management
-    bool updateVoiceState(uint8_t voiceId, const VoiceState& state);
+    // updateVoiceState(), setVoiceFrequency() and setVoiceSlide() only queue a
+    // command (control core). Each command carries the sample time it takes
+    // effect at (getSampleTime() timeline, default: as soon as possible); the
+    // audio core applies it exactly on that sample, splitting its blocks as
+    // needed. Times must not decrease from one command to the next, since a
+    // command never overtakes the ones queued before it.
+    bool updateVoiceState(uint8_t voiceId, const VoiceState& state) { return updateVoiceState(voiceId, state, getSampleTime()); }
+    bool updateVoiceState(uint8_t voiceId, const VoiceState& state, uint32_t atSample);
     VoiceState* getVoiceState(uint8_t voiceId);
     
     // Sequencer Management
@@ -50,7 +67,23 @@ public:
     // Audio Processing
     void init(float sampleRate);
     float processAllVoices();
+    void processAllVoicesBlock(float* out, size_t numSamples);
     float processVoice(uint8_t voiceId);
+    uint32_t getDroppedCommandCount() const { return droppedCommands; }
+
+    // Sample clock: index of the next sample the audio core will render
+    uint32_t getSampleTime() const { return sampleTime.load(std::memory_order_acquire); }
+
+    // How far behind their target sample commands were applied (0 = exact);
+    // written by the audio core, a snapshot when read from another core
+    struct EventTimingStats {
+        uint32_t events;      // commands applied
+        uint32_t late;        // applied after their target sample
+        uint32_t maxDelay;    // worst delay in samples
+        uint64_t totalDelay;  // sum of delays in samples
+    };
+    const EventTimingStats& getEventTimingStats() const { return eventTiming; }
+    void resetEventTimingStats() { eventTiming = EventTimingStats{}; }
     
     // Voice Control
     void enableVoice(uint8_t voiceId, bool enabled = true);
@@ -61,6 +94,7 @@ public:
     uint8_t getVoiceCount() const { return static_cast<uint8_t>(voices.size()); }
     uint8_t getMaxVoices() const { return maxVoiceCount; }
     std::vector<uint8_t> getActiveVoiceIds() const;
+    uint8_t getAwakeVoiceCount() const;
     
     // Memory Management
     size_t getMemoryUsage() const;
@@ -87,10 +121,25 @@ public:
     
     // Voice Parameter Control
     void setVoiceVolume(uint8_t voiceId, float volume);
-    void setVoiceFrequency(uint8_t voiceId, float frequency);
-    void setVoiceSlide(uint8_t voiceId, float slideTime);
+    bool setVoiceFrequency(uint8_t voiceId, float frequency) { return setVoiceFrequency(voiceId, frequency, getSampleTime()); }
+    bool setVoiceFrequency(uint8_t voiceId, float frequency, uint32_t atSample);
+    bool setVoiceSlide(uint8_t voiceId, float slideTime) { return setVoiceSlide(voiceId, slideTime, getSampleTime()); }
+    bool setVoiceSlide(uint8_t voiceId, float slideTime, uint32_t atSample);
     
+    // Commands in flight between the control and audio cores; one step update
+    // of all four voices queues 12
+    static constexpr size_t COMMAND_QUEUE_SIZE = 64;
+
 private:
+    struct VoiceCommand {
+        enum class Type : uint8_t { State, Frequency, Slide };
+        Type type;
+        uint8_t voiceId;
+        uint32_t when;     // sample time to apply at
+        float value;       // Frequency / Slide
+        VoiceState state;  // State
+    };
+
     struct ManagedVoice {
         std::unique_ptr<Voice> voice;
         uint8_t id;
@@ -107,6 +156,12 @@ private:
     uint8_t nextVoiceId;
     float sampleRate;
     float globalVolume;
+
+    SpscQueue<VoiceCommand, COMMAND_QUEUE_SIZE> commands;
+    uint32_t droppedCommands;
+    uint32_t lastQueuedWhen;  // latest `when` posted (core1, interrupts masked)
+    std::atomic<uint32_t> sampleTime;
+    EventTimingStats eventTiming;
     
     // Callbacks
     VoiceCountCallback voiceCountCallback;
@@ -118,6 +173,10 @@ private:
     uint8_t generateVoiceId();
     void notifyVoiceCountChanged();
     void notifyVoiceUpdated(uint8_t voiceId, const VoiceState& state);
+    bool postCommand(const VoiceCommand& command);
+    size_t processCommands(size_t maxSamples);
+    void applyCommand(const VoiceCommand& command);
+    void renderBlock(float* out, size_t n);
 };
 
 /**
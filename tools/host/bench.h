@@ -0,0 +1,38 @@
+#pragma once
+
+// Tiny timing helpers shared by the host micro-benchmarks.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench
+{
+// Keeps the optimiser from discarding a computed value.
+template <typename T> inline void keep(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs fn(samples) `repeats` times and returns the best ns/sample, which is
+// the most stable figure on a shared machine.
+template <typename Fn> double nsPerSample(Fn &&fn, size_t samples, int repeats = 5)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        fn(samples);
+        const auto t1 = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(samples);
+        if (ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+inline void row(const char *name, double ns, double referenceNs)
+{
+    std::printf("%-36s %8.2f ns/sample %7.1f%%\n", name, ns, 100.0 * ns / referenceNs);
+}
+} // namespace bench
@@ -0,0 +1,110 @@
+// Memory report and micro-benchmark for the global delay line.
+//
+// Compares daisysp::DelayLine<float, N> with daisysp::DelayLine16<N> at the
+// sketch's MAX_DELAY_SAMPLES, running the feedback loop of
+// processDelayEffect() (Read, one-pole feedback, Write) and a Hermite tap.
+
+#include "../../src/dsp/delayline.h"
+#include "../../src/dsp/delayline16.h"
+#include "../../src/dsp/oscillator.h"
+#include "bench.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kMaxDelaySamples = static_cast<size_t>(kSampleRate * 1.8f);
+constexpr size_t kSamples = 1 << 20;
+
+using FloatDelay = daisysp::DelayLine<float, kMaxDelaySamples>;
+using Int16Delay = daisysp::DelayLine16<kMaxDelaySamples>;
+
+std::vector<float> makeInput()
+{
+    std::vector<float> input(kSamples);
+    daisysp::Oscillator osc;
+    osc.Init(kSampleRate);
+    osc.SetWaveform(daisysp::Oscillator::WAVE_POLYBLEP_SAW);
+    osc.SetFreq(220.0f);
+    // Never fully silent, so a decaying tail cannot go denormal and dominate
+    // the timing on x86
+    for (size_t i = 0; i < kSamples; ++i)
+        input[i] = osc.Process() * ((i % 12000) < 3000 ? 1.0f : 0.1f);
+    return input;
+}
+
+template <typename Delay> double benchFeedback(Delay &del, const std::vector<float> &input, std::vector<float> &out)
+{
+    del.Init();
+    del.SetDelay(24000.5f);
+    float lp = 0.0f;
+    return bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const float delout = del.Read();
+                lp += 0.2f * (delout * 0.45f - lp);
+                del.Write(input[i] + lp * 0.75f);
+                out[i] = input[i] + delout;
+            }
+        },
+        kSamples, 3);
+}
+
+template <typename Delay> double benchHermite(Delay &del, const std::vector<float> &input)
+{
+    del.Init();
+    return bench::nsPerSample(
+        [&](size_t n) {
+            float t = 1000.0f;
+            for (size_t i = 0; i < n; ++i)
+            {
+                bench::keep(del.ReadHermite(t));
+                del.Write(input[i]);
+                t += 0.37f;
+                if (t > 60000.0f)
+                    t -= 59000.0f;
+            }
+        },
+        kSamples, 3);
+}
+} // namespace
+
+int main()
+{
+    // Two delay lines are larger than a default stack, keep them on the heap
+    auto floatDelay = std::make_unique<FloatDelay>();
+    auto int16Delay = std::make_unique<Int16Delay>();
+    const std::vector<float> input = makeInput();
+
+    std::printf("Delay line memory for MAX_DELAY_SAMPLES = %zu (%.2f s)\n", kMaxDelaySamples,
+                kMaxDelaySamples / kSampleRate);
+    std::printf("  %-28s %9zu bytes\n", "DelayLine<float, N>", sizeof(FloatDelay));
+    std::printf("  %-28s %9zu bytes (ring %zu samples, %.1f%%)\n\n", "DelayLine16<N>", sizeof(Int16Delay),
+                Int16Delay::kSize, 100.0 * sizeof(Int16Delay) / sizeof(FloatDelay));
+
+    std::vector<float> refOut(kSamples), candOut(kSamples);
+    const double refNs = benchFeedback(*floatDelay, input, refOut);
+    const double candNs = benchFeedback(*int16Delay, input, candOut);
+
+    double signal = 0.0, error = 0.0;
+    for (size_t i = 0; i < kSamples; ++i)
+    {
+        signal += static_cast<double>(refOut[i]) * refOut[i];
+        error += static_cast<double>(refOut[i] - candOut[i]) * (refOut[i] - candOut[i]);
+    }
+
+    std::printf("Feedback loop (Read + Write, as processDelayEffect)\n");
+    bench::row("DelayLine<float, N>", refNs, refNs);
+    bench::row("DelayLine16<N>", candNs, refNs);
+    std::printf("  output difference %.1f dB below signal\n\n", 10.0 * std::log10(signal / (error + 1e-30)));
+
+    std::printf("Moving Hermite tap (ReadHermite + Write)\n");
+    const double refHermite = benchHermite(*floatDelay, input);
+    bench::row("DelayLine<float, N>", refHermite, refHermite);
+    bench::row("DelayLine16<N>", benchHermite(*int16Delay, input), refHermite);
+    return 0;
+}
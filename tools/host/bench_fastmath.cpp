@@ -0,0 +1,162 @@
+// Accuracy and speed of the fast-math kernels in src/dsp/dsp.h against libm.
+//
+// Error is the largest deviation from the double-precision libm result over a
+// dense sweep of the domain (relative or absolute, as listed in dsp.h); time
+// is per call over a buffer of random arguments in the same domain, for the
+// single-precision libm function the kernel replaces and for the kernel.
+// SoftClip, the rational saturator the ladder filter uses, is listed against
+// tanh for comparison.
+//
+// The libm column is the host's (glibc has table-driven, vectorised float
+// exp/log/sin), so it flatters libm: on the Pico2 these are newlib's
+// software routines. The error column carries over unchanged.
+
+#include "../../src/dsp/dsp.h"
+#include "bench.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr size_t kArgs = 4096;
+constexpr size_t kCalls = 1 << 22;
+constexpr size_t kSweep = 1 << 21;
+
+enum class Error
+{
+    Absolute,
+    Relative
+};
+
+struct Kernel
+{
+    const char *name;
+    const char *domain;
+    float lo, hi;
+    bool logSpaced; // sweep and draw arguments evenly in log(x)
+    Error error;
+    float (*fast)(float);
+    float (*libm)(float);
+    double (*reference)(double);
+};
+
+float argAt(const Kernel &k, double t)
+{
+    if (k.logSpaced)
+        return static_cast<float>(std::exp(std::log(k.lo) + t * (std::log(k.hi) - std::log(k.lo))));
+    return static_cast<float>(k.lo + t * (static_cast<double>(k.hi) - k.lo));
+}
+
+double maxError(const Kernel &k)
+{
+    double worst = 0.0;
+    for (size_t i = 0; i <= kSweep; ++i)
+    {
+        const float x = argAt(k, static_cast<double>(i) / kSweep);
+        const double ref = k.reference(x);
+        double err = std::fabs(static_cast<double>(k.fast(x)) - ref);
+        if (k.error == Error::Relative)
+        {
+            if (ref == 0.0)
+                continue;
+            err /= std::fabs(ref);
+        }
+        worst = std::max(worst, err);
+    }
+    return worst;
+}
+
+double nsPerCall(float (*fn)(float), const std::vector<float> &args)
+{
+    return bench::nsPerSample(
+        [&](size_t n) {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; ++i)
+                acc += fn(args[i & (kArgs - 1)]);
+            bench::keep(acc);
+        },
+        kCalls);
+}
+
+// pow over x in [1e-3, 1], y in [0, 10]: the Adsr attack shape and the Svf
+// resonance use it there
+double powMaxError()
+{
+    double worst = 0.0;
+    for (size_t i = 0; i <= 2048; ++i)
+        for (size_t j = 0; j <= 1024; ++j)
+        {
+            const float x = static_cast<float>(std::pow(10.0, -3.0 + 3.0 * i / 2048.0));
+            const float y = static_cast<float>(10.0 * j / 1024.0);
+            const double ref = std::pow(static_cast<double>(x), static_cast<double>(y));
+            worst = std::max(worst, std::fabs(daisysp::fastpowf(x, y) - ref) / ref);
+        }
+    return worst;
+}
+} // namespace
+
+int main()
+{
+    using namespace daisysp;
+    static const Kernel kKernels[] = {
+        {"fastexp2f", "[-126, 126]", -126.0f, 126.0f, false, Error::Relative, fastexp2f,
+         [](float x) { return exp2f(x); }, [](double x) { return std::exp2(x); }},
+        {"fastexpf", "[-87, 87]", -87.0f, 87.0f, false, Error::Relative, fastexpf,
+         [](float x) { return expf(x); }, [](double x) { return std::exp(x); }},
+        {"fastexpm1f", "[-1, 1]", -1.0f, 1.0f, false, Error::Relative, fastexpm1f,
+         [](float x) { return expm1f(x); }, [](double x) { return std::expm1(x); }},
+        {"fastlog2f", "[2^-10, 2^10]", 1.0f / 1024, 1024.0f, true, Error::Absolute, fastlog2f,
+         [](float x) { return log2f(x); }, [](double x) { return std::log2(x); }},
+        {"fastlogf", "[2^-10, 2^10]", 1.0f / 1024, 1024.0f, true, Error::Absolute, fastlogf,
+         [](float x) { return logf(x); }, [](double x) { return std::log(x); }},
+        {"fastsin2pif", "[-100, 100]", -100.0f, 100.0f, false, Error::Absolute, fastsin2pif,
+         [](float x) { return sinf(x * TWOPI_F); }, [](double x) { return std::sin(x * 2.0 * M_PI); }},
+        {"fastsinf", "[-10, 10]", -10.0f, 10.0f, false, Error::Absolute, fastsinf,
+         [](float x) { return sinf(x); }, [](double x) { return std::sin(x); }},
+        {"fasttanhf", "[-10, 10]", -10.0f, 10.0f, false, Error::Relative, fasttanhf,
+         [](float x) { return tanhf(x); }, [](double x) { return std::tanh(x); }},
+        {"SoftClip (ladder)", "[-10, 10]", -10.0f, 10.0f, false, Error::Relative, SoftClip,
+         [](float x) { return tanhf(x); }, [](double x) { return std::tanh(x); }},
+    };
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::printf("%-18s %-14s %12s %9s %9s %8s\n", "kernel", "domain", "max error", "libm ns", "fast ns", "rel");
+    for (const Kernel &k : kKernels)
+    {
+        std::vector<float> args(kArgs);
+        for (float &a : args)
+            a = argAt(k, unit(rng));
+        const double err = maxError(k);
+        const double libmNs = nsPerCall(k.libm, args);
+        const double fastNs = nsPerCall(k.fast, args);
+        std::printf("%-18s %-14s %8.1e %s %9.2f %9.2f %7.1f%%\n", k.name, k.domain, err,
+                    k.error == Error::Relative ? "rel" : "abs", libmNs, fastNs, 100.0 * fastNs / libmNs);
+    }
+
+    // Two-argument pow: x in [1e-3, 1], y in [0, 10]
+    std::vector<float> xs(kArgs), ys(kArgs);
+    for (size_t i = 0; i < kArgs; ++i)
+    {
+        xs[i] = static_cast<float>(std::pow(10.0, -3.0 + 3.0 * unit(rng)));
+        ys[i] = static_cast<float>(10.0 * unit(rng));
+    }
+    const auto powNs = [&](float (*fn)(float, float)) {
+        return bench::nsPerSample(
+            [&](size_t n) {
+                float acc = 0.0f;
+                for (size_t i = 0; i < n; ++i)
+                    acc += fn(xs[i & (kArgs - 1)], ys[i & (kArgs - 1)]);
+                bench::keep(acc);
+            },
+            kCalls);
+    };
+    const double libmNs = powNs([](float x, float y) { return powf(x, y); });
+    const double fastNs = powNs(fastpowf);
+    std::printf("%-18s %-14s %8.1e rel %9.2f %9.2f %7.1f%%\n", "fastpowf", "x^[0, 10]", powMaxError(), libmNs, fastNs,
+                100.0 * fastNs / libmNs);
+    return 0;
+}
@@ -0,0 +1,312 @@
+// Micro-benchmark for daisysp::LadderFilter.
+//
+// 1. Per mode: the original implementation (ReferenceLadder below, a verbatim
+//    copy of the std::array + weightedSumForCurrentMode() version) against
+//    the mode-templated Process() and ProcessBlock().
+// 2. As Voice drives it: an envelope-swept cutoff updated every sample
+//    (SetFreq) versus the control-rate path (SetFreqRamped every
+//    VoiceConfig::controlBlockSize samples).
+
+#include "../../src/dsp/adsr.h"
+#include "../../src/dsp/ladder.h"
+#include "../../src/dsp/oscillator.h"
+#include "bench.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+using daisysp::LadderFilter;
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kSamples = 1 << 20;
+
+struct Fixture
+{
+    std::vector<float> input;
+    std::vector<float> envelope;
+
+    Fixture() : input(kSamples), envelope(kSamples)
+    {
+        daisysp::Oscillator osc;
+        osc.Init(kSampleRate);
+        osc.SetWaveform(daisysp::Oscillator::WAVE_POLYBLEP_SAW);
+        osc.SetFreq(110.0f);
+        daisysp::Adsr env;
+        env.Init(kSampleRate);
+        env.SetAttackTime(0.005f);
+        env.SetDecayTime(0.12f);
+        env.SetSustainLevel(0.5f);
+        env.SetReleaseTime(0.1f);
+        for (size_t i = 0; i < kSamples; ++i)
+        {
+            input[i] = osc.Process();
+            envelope[i] = env.Process((i % 12000) < 3000); // 16th notes at 120 BPM
+        }
+    }
+};
+
+// Pre-specialisation LadderFilter, kept here as the benchmark baseline.
+class ReferenceLadder
+{
+  public:
+    using FilterMode = LadderFilter::FilterMode;
+
+    void Init(float sample_rate)
+    {
+        sample_rate_  = sample_rate;
+        sr_int_recip_ = 1.0f / (sample_rate * kInterpolation);
+        alpha_        = 1.0f;
+        K_            = 1.0f;
+        Qadjust_      = 1.0f;
+        oldinput_     = 0.f;
+        mode_         = FilterMode::LP24;
+        pbg_          = 0.5f;
+        drive_        = 0.5f;
+        SetFreq(5000.f);
+        SetRes(0.2f);
+    }
+
+    float Process(float in)
+    {
+        float input  = in * drive_;
+        float total  = 0.0f;
+        float interp = 0.0f;
+        for(size_t os = 0; os < kInterpolation; os++)
+        {
+            float u = (interp * oldinput_ + (1.0f - interp) * input)
+                      - (z1_[5] - pbg_ * input) * K_ * Qadjust_;
+            u            = fast_tanh(u);
+            float stage1 = LPF(u, 0);
+            float stage2 = LPF(stage1, 1);
+            float stage3 = LPF(stage2, 2);
+            float stage4 = LPF(stage3, 3);
+            float stage5 = LPF(stage4, 4);
+            float stage6 = LPF(stage5, 5);
+            total += weightedSumForCurrentMode(
+                         {input, stage1, stage2, stage3, stage4, stage5, stage6})
+                     * kInterpolationRecip;
+            interp += kInterpolationRecip;
+        }
+        oldinput_ = input;
+        return total;
+    }
+
+    void SetFreq(float freq)
+    {
+        freq      = daisysp::fclamp(freq, 5.0f, sample_rate_ * 0.425f);
+        float wc  = freq * 2.0f * PI_F * sr_int_recip_;
+        float wc2 = wc * wc;
+        alpha_    = 0.9892f * wc - 0.4324f * wc2 + 0.1381f * wc * wc2
+                 - 0.0202f * wc2 * wc2;
+        Qadjust_ = 1.006f + 0.0536f * wc - 0.095f * wc2 - 0.05f * wc2 * wc2;
+    }
+
+    void SetRes(float res) { K_ = 4.0f * daisysp::fclamp(res, 0.0f, 1.8f); }
+    void SetInputDrive(float drv) { drive_ = daisysp::fclamp(drv, 0.0f, 4.0f); }
+    void SetPassbandGain(float pbg) { pbg_ = daisysp::fclamp(pbg, 0.0f, 0.5f); }
+    void SetFilterMode(FilterMode mode) { mode_ = mode; }
+
+  private:
+    static constexpr uint8_t kInterpolation      = 4;
+    static constexpr float   kInterpolationRecip = 1.0f / kInterpolation;
+
+    static inline float fast_tanh(float x)
+    {
+        if(x > 3.0f)
+            return 1.0f;
+        if(x < -3.0f)
+            return -1.0f;
+        float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    float LPF(float s, int i)
+    {
+        float ft = s * 0.76923077f + 0.23076923f * z0_[i] - z1_[i];
+        ft       = ft * alpha_ + z1_[i];
+        z1_[i]   = ft;
+        z0_[i]   = s;
+        return ft;
+    }
+
+    float weightedSumForCurrentMode(const std::array<float, 7>& stage_outs)
+    {
+        switch(mode_)
+        {
+            case FilterMode::LP36: return stage_outs[6];
+            case FilterMode::BP36: return (stage_outs[3] - stage_outs[6]) * 6.0f;
+            case FilterMode::LP24: return stage_outs[4];
+            case FilterMode::LP12: return stage_outs[2];
+            case FilterMode::BP24:
+                return (stage_outs[2] + stage_outs[4]) * 4.0f - stage_outs[3] * 8.0f;
+            case FilterMode::BP12: return (stage_outs[1] - stage_outs[2]) * 2.0f;
+            default: return stage_outs[6];
+        }
+    }
+
+    float      sample_rate_, sr_int_recip_;
+    float      alpha_;
+    float      z0_[6] = {0, 0, 0, 0, 0, 0};
+    float      z1_[6] = {0, 0, 0, 0, 0, 0};
+    float      K_, Qadjust_, pbg_, drive_, oldinput_;
+    FilterMode mode_;
+};
+
+template <typename Filter> void initFilter(Filter &f, LadderFilter::FilterMode mode)
+{
+    f.Init(kSampleRate);
+    f.SetRes(0.4f);
+    f.SetInputDrive(1.8f);
+    f.SetPassbandGain(0.23f);
+    f.SetFilterMode(mode);
+}
+
+inline float cutoffFor(float env)
+{
+    const float filterFrequency = 3000.0f;
+    return 100.f + (filterFrequency * env) + (filterFrequency * .1f);
+}
+
+double benchPerSample(const Fixture &fx, LadderFilter::FilterMode mode)
+{
+    LadderFilter f;
+    initFilter(f, mode);
+    return bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+            {
+                f.SetFreq(cutoffFor(fx.envelope[i]));
+                bench::keep(f.Process(fx.input[i]));
+            }
+        },
+        kSamples);
+}
+
+double benchControlRate(const Fixture &fx, LadderFilter::FilterMode mode, size_t block)
+{
+    LadderFilter f;
+    initFilter(f, mode);
+    return bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (i % block == 0)
+                    f.SetFreqRamped(cutoffFor(fx.envelope[i]), block);
+                bench::keep(f.Process(fx.input[i]));
+            }
+        },
+        kSamples);
+}
+
+struct ModeResult
+{
+    double reference, process, block, maxError;
+};
+
+ModeResult benchMode(const Fixture &fx, LadderFilter::FilterMode mode)
+{
+    const float cutoff = cutoffFor(0.5f);
+    ModeResult r{};
+
+    ReferenceLadder ref;
+    initFilter(ref, mode);
+    ref.SetFreq(cutoff);
+    std::vector<float> refOut(kSamples);
+    r.reference = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                refOut[i] = ref.Process(fx.input[i]);
+        },
+        kSamples);
+
+    LadderFilter f;
+    initFilter(f, mode);
+    f.SetFreq(cutoff);
+    r.process = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(f.Process(fx.input[i]));
+        },
+        kSamples);
+
+    // Accuracy against the reference from identical fresh state
+    ReferenceLadder ref2;
+    initFilter(ref2, mode);
+    ref2.SetFreq(cutoff);
+    LadderFilter f2;
+    initFilter(f2, mode);
+    f2.SetFreq(cutoff);
+    std::vector<float> buf(fx.input.begin(), fx.input.begin() + 48000);
+    f2.ProcessBlock(buf.data(), buf.size());
+    for (size_t i = 0; i < buf.size(); ++i)
+        r.maxError = std::max(r.maxError, static_cast<double>(std::fabs(buf[i] - ref2.Process(fx.input[i]))));
+
+    LadderFilter fb;
+    initFilter(fb, mode);
+    fb.SetFreq(cutoff);
+    std::vector<float> work(256);
+    r.block = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start + work.size() <= n; start += work.size())
+            {
+                std::copy(fx.input.begin() + start, fx.input.begin() + start + work.size(), work.begin());
+                fb.ProcessBlock(work.data(), work.size());
+                bench::keep(work[0]);
+            }
+        },
+        kSamples);
+    return r;
+}
+
+double benchFixedCutoff(const Fixture &fx, LadderFilter::FilterMode mode)
+{
+    LadderFilter f;
+    initFilter(f, mode);
+    f.SetFreq(cutoffFor(0.5f));
+    return bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(f.Process(fx.input[i]));
+        },
+        kSamples);
+}
+} // namespace
+
+int main()
+{
+    const Fixture fx;
+
+    static const struct
+    {
+        LadderFilter::FilterMode mode;
+        const char *name;
+    } kModes[] = {
+        {LadderFilter::FilterMode::LP12, "LP12"}, {LadderFilter::FilterMode::LP24, "LP24"},
+        {LadderFilter::FilterMode::LP36, "LP36"}, {LadderFilter::FilterMode::BP12, "BP12"},
+        {LadderFilter::FilterMode::BP24, "BP24"}, {LadderFilter::FilterMode::BP36, "BP36"},
+    };
+
+    std::printf("LadderFilter per mode, fixed cutoff (ns/sample)\n");
+    std::printf("%-6s %10s %10s %8s %14s %8s %12s\n", "mode", "reference", "Process", "", "ProcessBlock", "",
+                "max |error|");
+    for (const auto &m : kModes)
+    {
+        const ModeResult r = benchMode(fx, m.mode);
+        std::printf("%-6s %10.2f %10.2f %7.1f%% %14.2f %7.1f%% %12.2e\n", m.name, r.reference, r.process,
+                    100.0 * r.process / r.reference, r.block, 100.0 * r.block / r.reference, r.maxError);
+    }
+    std::printf("\n");
+
+    const auto mode = LadderFilter::FilterMode::LP24;
+
+    std::printf("LadderFilter LP24, envelope-swept cutoff\n");
+    const double perSample = benchPerSample(fx, mode);
+    bench::row("SetFreq every sample", perSample, perSample);
+    bench::row("SetFreqRamped every 16 samples", benchControlRate(fx, mode, 16), perSample);
+    bench::row("SetFreqRamped every 32 samples", benchControlRate(fx, mode, 32), perSample);
+    bench::row("fixed cutoff (lower bound)", benchFixedCutoff(fx, mode), perSample);
+    return 0;
+}
@@ -0,0 +1,202 @@
+// Micro-benchmark for daisysp::OscillatorBank against daisysp::Oscillator.
+//
+// For each PolyBLEP waveform Voice uses, renders three detuned oscillators
+// mixed into one buffer the way Voice::renderSourceBlock() does: with three
+// Oscillator objects called per sample, and with one OscillatorBank rendering
+// each oscillator a block at a time. The last column is the largest sample
+// difference over the first 4800 samples; the two keep phase with different
+// precision (float vs 32-bit integer), so it grows slowly with time.
+//
+// The second table is the same bank during a slide: the old per-sample Hz
+// slew with SetFreq() before every sample, against the pitch-domain glide
+// Voice now runs, stepped once per 16-sample control block with
+// SetFreqRamped() ramping the phase increment in between.
+
+#include "../../src/dsp/oscillator.h"
+#include "../../src/dsp/oscillator_bank.h"
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using daisysp::Oscillator;
+using daisysp::OscillatorBank;
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kSamples = 1 << 20;
+constexpr size_t kBlock = 64;
+constexpr size_t kCount = 3;
+constexpr float kFreqs[kCount] = {110.0f, 110.0f * 1.001f, 110.0f * 0.999f};
+constexpr size_t kErrorSamples = 4800;
+
+void initOscillators(Oscillator (&osc)[kCount], uint8_t waveform)
+{
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        osc[i].Init(kSampleRate);
+        osc[i].SetWaveform(waveform);
+        osc[i].SetAmp(0.3f);
+        osc[i].SetFreq(kFreqs[i]);
+    }
+}
+
+void initBank(OscillatorBank &bank, uint8_t waveform)
+{
+    bank.Init(kSampleRate, kCount);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        bank.SetWaveform(i, waveform);
+        bank.SetAmp(i, 0.3f);
+        bank.SetFreq(i, kFreqs[i]);
+    }
+}
+
+struct Result
+{
+    double oscillator, bank, maxError;
+};
+
+Result benchWaveform(uint8_t waveform)
+{
+    Result r{};
+    float out[kBlock];
+
+    Oscillator osc[kCount];
+    initOscillators(osc, waveform);
+    r.oscillator = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start < n; start += kBlock)
+            {
+                std::fill(out, out + kBlock, 0.0f);
+                for (auto &o : osc)
+                    for (size_t i = 0; i < kBlock; ++i)
+                        out[i] += o.Process();
+                bench::keep(out[0]);
+            }
+        },
+        kSamples);
+
+    OscillatorBank bank;
+    initBank(bank, waveform);
+    r.bank = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start < n; start += kBlock)
+            {
+                std::fill(out, out + kBlock, 0.0f);
+                for (size_t i = 0; i < kCount; ++i)
+                    bank.ProcessAdd(i, out, kBlock);
+                bench::keep(out[0]);
+            }
+        },
+        kSamples);
+
+    Oscillator refOsc[kCount];
+    initOscillators(refOsc, waveform);
+    OscillatorBank refBank;
+    initBank(refBank, waveform);
+    std::vector<float> a(kErrorSamples, 0.0f), b(kErrorSamples, 0.0f);
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        for (size_t j = 0; j < kErrorSamples; ++j)
+            a[j] += refOsc[i].Process();
+        refBank.ProcessAdd(i, b.data(), kErrorSamples);
+    }
+    for (size_t j = 0; j < kErrorSamples; ++j)
+        r.maxError = std::max(r.maxError, static_cast<double>(std::fabs(a[j] - b[j])));
+    return r;
+}
+constexpr size_t kControlBlock = 16;
+constexpr float kSlewRate = 0.00035f; // Voice's FREQ_SLEW_RATE
+
+// Glide 110 Hz -> 440 Hz and back, restarted every 0.5 s so the slew never settles
+struct SlideResult
+{
+    double perSample, ramped;
+};
+
+SlideResult benchSlide(uint8_t waveform)
+{
+    SlideResult r{};
+    float out[kBlock];
+    constexpr size_t kRestart = 24000;
+
+    OscillatorBank bank;
+    initBank(bank, waveform);
+    float freq[kCount] = {110.0f, 110.0f, 110.0f};
+    size_t t = 0;
+    r.perSample = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start < n; start += kBlock, t += kBlock)
+            {
+                const float target = (t / kRestart) & 1 ? 110.0f : 440.0f;
+                std::fill(out, out + kBlock, 0.0f);
+                for (size_t i = 0; i < kCount; ++i)
+                    for (size_t j = 0; j < kBlock; ++j)
+                    {
+                        freq[i] = std::fmaf(target - freq[i], kSlewRate, freq[i]);
+                        bank.SetFreq(i, freq[i]);
+                        out[j] += bank.Process(i);
+                    }
+                bench::keep(out[0]);
+            }
+        },
+        kSamples);
+
+    initBank(bank, waveform);
+    const float keep = std::pow(1.0f - kSlewRate, static_cast<float>(kControlBlock));
+    float pitch[kCount] = {45.0f, 45.0f, 45.0f}; // MIDI A2
+    t = 0;
+    r.ramped = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start < n; start += kBlock, t += kBlock)
+            {
+                const float target = (t / kRestart) & 1 ? 45.0f : 69.0f;
+                std::fill(out, out + kBlock, 0.0f);
+                for (size_t i = 0; i < kCount; ++i)
+                    for (size_t j = 0; j < kBlock; j += kControlBlock)
+                    {
+                        pitch[i] = std::fmaf(pitch[i] - target, keep, target);
+                        bank.SetFreqRamped(i, daisysp::mtof(pitch[i]), kControlBlock);
+                        bank.ProcessAdd(i, out + j, kControlBlock);
+                    }
+                bench::keep(out[0]);
+            }
+        },
+        kSamples);
+    return r;
+}
+} // namespace
+
+int main()
+{
+    static const struct
+    {
+        uint8_t waveform;
+        const char *name;
+    } kWaveforms[] = {
+        {Oscillator::WAVE_POLYBLEP_SAW, "WAVE_POLYBLEP_SAW"},
+        {Oscillator::WAVE_POLYBLEP_SQUARE, "WAVE_POLYBLEP_SQUARE"},
+        {Oscillator::WAVE_POLYBLEP_TRI, "WAVE_POLYBLEP_TRI"},
+    };
+
+    std::printf("3 oscillators mixed, %zu-sample blocks (ns per output sample)\n", kBlock);
+    std::printf("%-22s %11s %15s %8s %12s\n", "waveform", "Oscillator", "OscillatorBank", "", "max |error|");
+    for (const auto &w : kWaveforms)
+    {
+        const Result r = benchWaveform(w.waveform);
+        std::printf("%-22s %11.2f %15.2f %7.1f%% %12.2e\n", w.name, r.oscillator, r.bank,
+                    100.0 * r.bank / r.oscillator, r.maxError);
+    }
+
+    std::printf("\nsliding, OscillatorBank (ns per output sample)\n");
+    std::printf("%-22s %11s %15s\n", "waveform", "Hz/sample", "pitch/ramped");
+    for (const auto &w : kWaveforms)
+    {
+        const SlideResult r = benchSlide(w.waveform);
+        std::printf("%-22s %11.2f %15.2f %7.1f%%\n", w.name, r.perSample, r.ramped, 100.0 * r.ramped / r.perSample);
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+// Micro-benchmark for daisysp::Particle.
+//
+// ReferenceParticle below is the previous implementation: the global libc
+// rand() twice per sample, and on every grain fastexp2f, sqrtf and a full
+// Svf::SetFreq()/SetRes(), with all five Svf responses computed per sample.
+// Particle draws from its own xorshift32, looks each grain's filter
+// coefficients up in its spread table and computes only the band-pass.
+// Timed with the Particle preset's settings, with sync (a new grain every
+// sample) and as Voice drives it: density from the envelope every 16 samples
+// and a new note, so a new centre frequency, every 6000 samples.
+
+#include "../../src/dsp/particle.h"
+#include "../../src/dsp/dsp.h"
+#include "bench.h"
+
+#include <cmath>
+#include <cstdlib>
+
+using daisysp::Particle;
+using daisysp::Svf;
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kSamples = 1 << 20;
+
+// Pre-change Particle, kept here as the benchmark baseline
+class ReferenceParticle
+{
+  public:
+    void Init(float sample_rate)
+    {
+        sample_rate_ = sample_rate;
+        sync_        = false;
+        SetFreq(440.f);
+        resonance_ = .9f;
+        density_   = .5f;
+        density_root_ = sqrtf(density_);
+        gain_      = 1.f;
+        spread_    = 1.f;
+        rand_freq_ = daisysp::fclamp(1.f / 48.f, 0.f, 1.f);
+        rand_phase_ = 0.f;
+        pre_gain_   = 0.0f;
+        filter_.Init(sample_rate_);
+        filter_.SetDrive(.7f);
+    }
+
+    float Process()
+    {
+        float u = static_cast<float>(rand()) * kRandFrac;
+        float s = 0.0f;
+        if(u <= density_ || sync_)
+        {
+            s = u <= density_ ? u * gain_ : s;
+            rand_phase_ += rand_freq_;
+            if(rand_phase_ >= 1.f || sync_)
+            {
+                rand_phase_ = rand_phase_ >= 1.f ? rand_phase_ - 1.f : rand_phase_;
+                const float u = 2.0f * static_cast<float>(rand()) * kRandFrac - 1.0f;
+                const float f = fminf(daisysp::fastexp2f(kRatioFrac * spread_ * u) * frequency_, .25f);
+                pre_gain_ = 0.5f / sqrtf(resonance_ * f * density_root_);
+                filter_.SetFreq(f * sample_rate_);
+                filter_.SetRes(resonance_);
+            }
+        }
+        filter_.Process(pre_gain_ * s);
+        return filter_.Band();
+    }
+
+    void SetFreq(float freq) { frequency_ = daisysp::fclamp(freq / sample_rate_, 0.f, 1.f); }
+    void SetResonance(float resonance) { resonance_ = daisysp::fclamp(resonance, 0.f, 1.f); }
+    void SetDensity(float density)
+    {
+        density_      = daisysp::fclamp(density * .3f, 0.f, 1.f);
+        density_root_ = sqrtf(density_);
+    }
+    void SetGain(float gain) { gain_ = daisysp::fclamp(gain, 0.f, 1.f); }
+    void SetSpread(float spread) { spread_ = spread < 0.f ? 0.f : spread; }
+    void SetSync(bool sync) { sync_ = sync; }
+
+  private:
+    static constexpr float kRandFrac = 1.f / static_cast<float>(RAND_MAX);
+    static constexpr float kRatioFrac = 1.f / 12.f;
+    float sample_rate_, frequency_, density_, density_root_, gain_, spread_, resonance_;
+    bool sync_;
+    float rand_phase_, rand_freq_, pre_gain_;
+    Svf filter_;
+};
+
+// The Particle preset (getParticleVoice())
+template <typename P> void initParticle(P &p, bool sync)
+{
+    p.Init(kSampleRate);
+    p.SetFreq(220.f);
+    p.SetResonance(0.42f);
+    p.SetDensity(0.9f);
+    p.SetGain(0.8f);
+    p.SetSpread(2.0f);
+    p.SetSync(sync);
+}
+
+template <typename P> double benchSteady(bool sync)
+{
+    P p;
+    initParticle(p, sync);
+    return bench::nsPerSample(
+        [&](size_t n) {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; ++i)
+                acc += p.Process();
+            bench::keep(acc);
+        },
+        kSamples);
+}
+
+template <typename P> double benchAsVoice()
+{
+    P p;
+    initParticle(p, false);
+    static const float kNotes[] = {220.0f, 261.6f, 329.6f, 392.0f, 220.0f, 196.0f};
+    return bench::nsPerSample(
+        [&](size_t n) {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (i % 6000 == 0)
+                    p.SetFreq(kNotes[(i / 6000) % 6]);
+                if (i % 16 == 0)
+                {
+                    const float env = 1.0f - static_cast<float>(i % 6000) / 6000.0f;
+                    p.SetDensity(0.9f * env);
+                }
+                acc += p.Process();
+            }
+            bench::keep(acc);
+        },
+        kSamples);
+}
+
+void row(const char *name, double reference, double current)
+{
+    std::printf("%-24s %10.2f %10.2f %7.1f%%\n", name, reference, current, 100.0 * current / reference);
+}
+} // namespace
+
+int main()
+{
+    std::printf("%-24s %10s %10s %8s\n", "Particle (ns/sample)", "reference", "current", "rel");
+    row("preset, steady note", benchSteady<ReferenceParticle>(false), benchSteady<Particle>(false));
+    row("preset, sync", benchSteady<ReferenceParticle>(true), benchSteady<Particle>(true));
+    row("as Voice drives it", benchAsVoice<ReferenceParticle>(), benchAsVoice<Particle>());
+    return 0;
+}
@@ -0,0 +1,98 @@
+// Step reads of one updateStepLEDs() pass (the default page, renderVoicePair()
+// for voices 1/2): 16 steps of two sequencers, gate, slide and playhead.
+//
+// The LED code itself needs FastLED, so only the sequencer side is timed:
+//   getStep          - what renderVoicePair() did before the packed cache:
+//                      getStep() plus a second Slide lookup per step
+//   packed, clean    - getPackedSteps() with nothing edited since last frame
+//   packed, 1 edit   - one setStepParameterValue() per frame, as while a
+//                      parameter button is held and the sensor records
+//   packed, resize   - a track length change every frame (all steps re-read)
+
+#include "../../src/sequencer/Sequencer.h"
+#include "bench.h"
+
+namespace
+{
+constexpr size_t kFrames = 1 << 15;
+constexpr int kSteps = 16;
+
+void prepare(Sequencer &seq)
+{
+    for (uint8_t i = 0; i < kSteps; ++i)
+    {
+        seq.setStepParameterValue(ParamId::Gate, i, (i % 3) ? 1.0f : 0.0f);
+        seq.setStepParameterValue(ParamId::Slide, i, (i % 5) ? 0.0f : 1.0f);
+    }
+}
+
+// Stands in for the colour choice: enough to keep every read alive
+uint32_t mix(bool gate, bool slide, bool playhead)
+{
+    return (gate ? 1u : 0u) + (slide ? 2u : 0u) + (playhead ? 4u : 0u);
+}
+
+uint32_t frameGetStep(const Sequencer &a, const Sequencer &b)
+{
+    uint32_t acc = 0;
+    for (int step = 0; step < kSteps; ++step)
+    {
+        const Step sa = a.getStep(step);
+        acc += mix(sa.gate, a.getStepParameterValue(ParamId::Slide, step) > 0,
+                   a.getCurrentStepForParameter(ParamId::Gate) == step);
+        const Step sb = b.getStep(step);
+        acc += mix(sb.gate, b.getStepParameterValue(ParamId::Slide, step) > 0,
+                   b.getCurrentStepForParameter(ParamId::Gate) == step);
+    }
+    return acc;
+}
+
+uint32_t framePacked(const Sequencer &a, const Sequencer &b)
+{
+    const PackedStep *stepsA = a.getPackedSteps();
+    const PackedStep *stepsB = b.getPackedSteps();
+    uint32_t acc = 0;
+    for (int step = 0; step < kSteps; ++step)
+    {
+        acc += mix(stepsA[step].gate(), stepsA[step].slide(), a.getCurrentStepForParameter(ParamId::Gate) == step);
+        acc += mix(stepsB[step].gate(), stepsB[step].slide(), b.getCurrentStepForParameter(ParamId::Gate) == step);
+    }
+    return acc;
+}
+
+template <typename Frame> double nsPerFrame(Frame &&frame)
+{
+    return bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(frame(i));
+        },
+        kFrames);
+}
+} // namespace
+
+int main()
+{
+    Sequencer a(0), b(1);
+    prepare(a);
+    prepare(b);
+
+    const double getStepNs = nsPerFrame([&](size_t) { return frameGetStep(a, b); });
+    const double cleanNs = nsPerFrame([&](size_t) { return framePacked(a, b); });
+    const double editNs = nsPerFrame([&](size_t i) {
+        a.setStepParameterValue(ParamId::Filter, i % kSteps, (i & 0xff) / 255.0f);
+        return framePacked(a, b);
+    });
+    const double resizeNs = nsPerFrame([&](size_t i) {
+        a.setParameterStepCount(ParamId::Velocity, (i & 1) ? 12 : 16);
+        return framePacked(a, b);
+    });
+
+    std::printf("updateStepLEDs step reads, 2 voices x %d steps\n", kSteps);
+    std::printf("%-16s %12s %8s\n", "path", "ns/frame", "rel");
+    std::printf("%-16s %12.1f %7.1f%%\n", "getStep", getStepNs, 100.0);
+    std::printf("%-16s %12.1f %7.1f%%\n", "packed, clean", cleanNs, 100.0 * cleanNs / getStepNs);
+    std::printf("%-16s %12.1f %7.1f%%\n", "packed, 1 edit", editNs, 100.0 * editNs / getStepNs);
+    std::printf("%-16s %12.1f %7.1f%%\n", "packed, resize", resizeNs, 100.0 * resizeNs / getStepNs);
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Micro-benchmark for the single-output daisysp::Svf kernels.
+//
+// Every voice runs a high-pass Svf and the delay feedback path a low-pass
+// one, each reading a single response. Per filter, the full Process() plus
+// accessor (all five outputs averaged every sample) against Process<Out>()
+// and ProcessBlock<Out>(), which compute only the response read. The error
+// column is the largest difference to Process() from identical state (0 when
+// bit-identical). "saved per voice" is what one voice's high-pass no longer
+// costs per second of 48 kHz audio on this machine.
+
+#include "../../src/dsp/oscillator.h"
+#include "../../src/dsp/svf.h"
+#include "bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using daisysp::Svf;
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+constexpr size_t kSamples = 1 << 20;
+constexpr size_t kBlock = 256;
+
+struct Setup
+{
+    const char *name;
+    Svf::Output output;
+    float freq, res, drive;
+};
+
+// Voice high-pass (the digital preset) and the sketch's delLowPass
+constexpr Setup kSetups[] = {
+    {"voice high-pass", Svf::Output::High, 170.0f, 0.5f, 0.5f},
+    {"delay low-pass", Svf::Output::Low, 1340.0f, 0.19f, 0.9f},
+};
+
+Svf makeFilter(const Setup &s)
+{
+    Svf f;
+    f.Init(kSampleRate);
+    f.SetFreq(s.freq);
+    f.SetRes(s.res);
+    f.SetDrive(s.drive);
+    return f;
+}
+
+float fullOutput(Svf &f, Svf::Output output, float in)
+{
+    f.Process(in);
+    return output == Svf::Output::High ? f.High() : f.Low();
+}
+
+template <Svf::Output Out> struct Result
+{
+    double full, single, block, maxError;
+};
+
+template <Svf::Output Out> Result<Out> run(const Setup &s, const std::vector<float> &input)
+{
+    Result<Out> r{};
+
+    Svf full = makeFilter(s);
+    r.full = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(fullOutput(full, Out, input[i]));
+        },
+        kSamples);
+
+    Svf single = makeFilter(s);
+    r.single = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(single.Process<Out>(input[i]));
+        },
+        kSamples);
+
+    Svf block = makeFilter(s);
+    std::vector<float> work(kBlock);
+    r.block = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t start = 0; start + kBlock <= n; start += kBlock)
+            {
+                std::copy(input.begin() + start, input.begin() + start + kBlock, work.begin());
+                block.ProcessBlock<Out>(work.data(), kBlock);
+                bench::keep(work[0]);
+            }
+        },
+        kSamples);
+
+    // Accuracy from identical fresh state: per sample and in blocks
+    Svf ref = makeFilter(s), one = makeFilter(s), blk = makeFilter(s);
+    std::vector<float> buf(input.begin(), input.begin() + 48000);
+    for (size_t start = 0; start < buf.size(); start += kBlock)
+        blk.ProcessBlock<Out>(buf.data() + start, std::min(kBlock, buf.size() - start));
+    for (size_t i = 0; i < buf.size(); ++i)
+    {
+        const float expected = fullOutput(ref, Out, input[i]);
+        r.maxError = std::max({r.maxError, static_cast<double>(std::fabs(one.Process<Out>(input[i]) - expected)),
+                               static_cast<double>(std::fabs(buf[i] - expected))});
+    }
+    return r;
+}
+
+template <Svf::Output Out> double report(const Setup &s, const std::vector<float> &input)
+{
+    const Result<Out> r = run<Out>(s, input);
+    std::printf("%s (%.0f Hz, res %.2f), max |error| %.1e\n", s.name, static_cast<double>(s.freq),
+                static_cast<double>(s.res), r.maxError);
+    bench::row("Process() + accessor", r.full, r.full);
+    bench::row("Process<Out>()", r.single, r.full);
+    bench::row("ProcessBlock<Out>()", r.block, r.full);
+    std::printf("\n");
+    return r.full - r.block;
+}
+} // namespace
+
+int main()
+{
+    std::vector<float> input(kSamples);
+    daisysp::Oscillator osc;
+    osc.Init(kSampleRate);
+    osc.SetWaveform(daisysp::Oscillator::WAVE_POLYBLEP_SAW);
+    osc.SetFreq(110.0f);
+    for (float &x : input)
+        x = osc.Process();
+
+    const double savedNs = report<Svf::Output::High>(kSetups[0], input);
+    report<Svf::Output::Low>(kSetups[1], input);
+
+    std::printf("saved per voice: %.2f ns/sample, %.0f us per second of audio (%.2f%% of one core)\n", savedNs,
+                savedNs * kSampleRate / 1000.0, savedNs * kSampleRate / 1e7);
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Memory and lookup cost of the parameter track storage.
+//
+// Binary tracks (Gate, Slide) keep one bit per step and the others 16-bit
+// fixed point (QuantizedValues). For comparison the same ParameterTrack is
+// also instantiated with 32-bit float values, the layout every track used
+// before. Reports the size of one bank of nine tracks and of the sequencer
+// objects, the time per lookup for each storage and for the ParameterManager
+// calls the sequencer makes per step, then the bulk pattern edits.
+
+#include "../../src/sequencer/Sequencer.h"
+#include "bench.h"
+
+namespace
+{
+constexpr size_t kLookups = 1 << 20;
+
+// Storage every track used before quantization
+template <uint8_t SIZE> struct FloatValues
+{
+    float v[SIZE];
+
+    void setRange(float) {}
+    float get(uint8_t i) const { return v[i]; }
+    void set(uint8_t i, float value) { v[i] = value; }
+};
+
+using FloatTrack = ParameterTrack<FloatValues<SEQUENCER_MAX_STEPS>, SEQUENCER_MAX_STEPS>;
+using QuantizedTrack = ParameterTrack<QuantizedValues<SEQUENCER_MAX_STEPS>, SEQUENCER_MAX_STEPS>;
+using BinaryTrack = ParameterTrack<BinaryValues<SEQUENCER_MAX_STEPS>, SEQUENCER_MAX_STEPS>;
+
+template <typename Track> double nsPerLookup(const Track &track)
+{
+    return bench::nsPerSample(
+        [&](size_t n) {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; ++i)
+                acc += track.getValue(static_cast<uint8_t>(i * 7));
+            bench::keep(acc);
+        },
+        kLookups);
+}
+
+template <typename Track> Track makeTrack(float maxValue)
+{
+    Track t;
+    t.init(0.0f, maxValue);
+    for (uint8_t i = 0; i < SEQUENCER_MAX_STEPS; ++i)
+        t.setValue(i, maxValue * ((i * 37) % 64) / 63.0f);
+    return t;
+}
+} // namespace
+
+int main()
+{
+    const size_t floatBank = PARAM_ID_COUNT * sizeof(FloatTrack);
+    constexpr ParameterTrackSlots slots{};
+    const size_t packedBank = slots.quantizedCount * sizeof(QuantizedTrack) + slots.binaryCount * sizeof(BinaryTrack);
+    std::printf("one bank of %u tracks x %u steps\n", PARAM_ID_COUNT, SEQUENCER_MAX_STEPS);
+    std::printf("  float tracks        %6zu bytes\n", floatBank);
+    std::printf("  quantized + bitset  %6zu bytes (%.0f%%)\n", packedBank, 100.0 * packedBank / floatBank);
+    std::printf("ParameterManager      %6zu bytes (two banks)\n", sizeof(ParameterManager));
+    std::printf("4 x Sequencer         %6zu bytes\n\n", 4 * sizeof(Sequencer));
+
+    const FloatTrack floatTrack = makeTrack<FloatTrack>(1.0f);
+    const QuantizedTrack quantizedTrack = makeTrack<QuantizedTrack>(1.0f);
+    const BinaryTrack binaryTrack = makeTrack<BinaryTrack>(1.0f);
+
+    Sequencer seq(1);
+    seq.randomizeParameters();
+    ParameterManager manager;
+    manager.init();
+
+    const double floatNs = nsPerLookup(floatTrack);
+    std::printf("%-36s %8s %8s\n", "lookup", "ns", "rel");
+    std::printf("%-36s %8.2f %7.1f%%\n", "float track getValue", floatNs, 100.0);
+    const double quantizedNs = nsPerLookup(quantizedTrack);
+    std::printf("%-36s %8.2f %7.1f%%\n", "quantized track getValue", quantizedNs, 100.0 * quantizedNs / floatNs);
+    const double binaryNs = nsPerLookup(binaryTrack);
+    std::printf("%-36s %8.2f %7.1f%%\n", "binary track getValue", binaryNs, 100.0 * binaryNs / floatNs);
+
+    const double managerNs = bench::nsPerSample(
+        [&](size_t n) {
+            float acc = 0.0f;
+            for (size_t i = 0; i < n; ++i)
+                acc += manager.getValue(static_cast<ParamId>(i % PARAM_ID_COUNT), static_cast<uint8_t>(i));
+            bench::keep(acc);
+        },
+        kLookups);
+    std::printf("%-36s %8.2f\n", "ParameterManager::getValue", managerNs);
+
+    const double stepNs = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                bench::keep(seq.getStep(static_cast<uint8_t>(i)));
+        },
+        kLookups / 8);
+    std::printf("%-36s %8.2f\n", "Sequencer::getStep (9 values)", stepNs);
+
+    const double editNs = bench::nsPerSample(
+        [&](size_t n) {
+            for (size_t i = 0; i < n; ++i)
+                manager.setValue(ParamId::Filter, static_cast<uint8_t>(i), (i & 0xff) / 255.0f);
+        },
+        kLookups / 64);
+    std::printf("%-36s %8.2f\n", "ParameterManager::setValue (publish)", editNs);
+
+    // Whole-pattern edits, per call. "per step" is what resetAllSteps() used
+    // to do: 9 x 64 setValue() calls inside one batch
+    constexpr size_t kOps = 1 << 12;
+    Sequencer other(2);
+    const auto perOp = [&](auto &&op) {
+        return bench::nsPerSample(
+                   [&](size_t n) {
+                       for (size_t i = 0; i < n; ++i)
+                           op(i);
+                   },
+                   kOps) /
+               1000.0;
+    };
+    std::printf("\n%-36s %8s\n", "pattern edit", "us");
+    std::printf("%-36s %8.2f\n", "reset, per step", perOp([&](size_t) {
+                    manager.beginUpdate();
+                    for (uint8_t id = 0; id < PARAM_ID_COUNT; ++id)
+                        for (uint8_t step = 0; step < SEQUENCER_MAX_STEPS; ++step)
+                            manager.setValue(static_cast<ParamId>(id), step, 0.0f);
+                    manager.endUpdate();
+                }));
+    std::printf("%-36s %8.2f\n", "reset, clearAll()", perOp([&](size_t) { manager.clearAll(); }));
+    std::printf("%-36s %8.2f\n", "Sequencer::rotatePattern", perOp([&](size_t i) { seq.rotatePattern((i & 1) ? 1 : -1); }));
+    std::printf("%-36s %8.2f\n", "Sequencer::reversePattern", perOp([&](size_t) { seq.reversePattern(); }));
+    std::printf("%-36s %8.2f\n", "Sequencer::transpose", perOp([&](size_t i) { seq.transpose((i & 1) ? 1 : -1); }));
+    std::printf("%-36s %8.2f\n", "Sequencer::copyPatternFrom", perOp([&](size_t) { other.copyPatternFrom(seq); }));
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Voice-count sweep for VoiceManager::processAllVoicesBlock().
+//
+// Renders 1..8 gated voices cycling through the presets and reports the cost
+// per output sample and per voice. Built twice by the Makefile: bench_voices
+// uses the voice-by-voice engine, bench_voices_soa the structure-of-arrays
+// engine (VOICE_SOA_ENGINE=1), so the two tables can be compared directly.
+
+#include "../../src/voice/VoiceManager.h"
+#include "bench.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr size_t kSamples = 1 << 18;
+constexpr size_t kBufferSize = 256;
+constexpr uint8_t kPresetCount = 7;
+
+std::unique_ptr<VoiceManager> makeVoices(uint8_t count)
+{
+    auto manager = std::make_unique<VoiceManager>(8);
+    for (uint8_t v = 0; v < count; ++v)
+    {
+        const uint8_t id = manager->addVoice(VoicePresets::getPresetConfig(v % kPresetCount));
+        VoiceState state;
+        state.note = static_cast<float>(3 * v);
+        state.filter = 0.3f + 0.08f * v;
+        state.attack = 0.01f;
+        state.decay = 0.4f;
+        state.gate = true;
+        state.retrigger = true;
+        manager->updateVoiceState(id, state);
+    }
+    return manager;
+}
+} // namespace
+
+int main()
+{
+    std::printf("VoiceManager::processAllVoicesBlock, %s engine\n", VOICE_SOA_ENGINE ? "SoA" : "per-voice");
+    std::printf("%-8s %14s %14s\n", "voices", "ns/sample", "ns/voice");
+
+    std::vector<float> out(kBufferSize);
+    for (uint8_t count = 1; count <= 8; ++count)
+    {
+        auto manager = makeVoices(count);
+        const double ns = bench::nsPerSample(
+            [&](size_t n) {
+                for (size_t done = 0; done < n; done += kBufferSize)
+                {
+                    manager->processAllVoicesBlock(out.data(), kBufferSize);
+                    bench::keep(out[0]);
+                }
+            },
+            kSamples);
+        std::printf("%-8u %14.2f %14.2f\n", count, ns, ns / count);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Spectral comparison of two renders from tools/host/render.
+//
+// Averages the magnitude spectrum of each file (left channel, Hann-windowed
+// 4096-point frames, 50% overlap), folds it into third-octave bands and
+// reports the per-band level difference. Used to confirm that an optimisation
+// does not audibly change the engine's output even when the samples are no
+// longer bit-identical. Exit status is 1 when any band deviates by more than
+// the tolerance.
+//
+// usage: compare REFERENCE.wav CANDIDATE.wav [tolerance_db]
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr size_t kFrameSize = 4096;
+constexpr float kSampleRate = 48000.0f;
+constexpr float kFloorDb = -100.0f; // bands quieter than this are not compared
+
+bool readWavLeft(const char *path, std::vector<float> &out)
+{
+    FILE *f = std::fopen(path, "rb");
+    if (!f)
+    {
+        std::perror(path);
+        return false;
+    }
+    uint8_t header[44];
+    if (std::fread(header, 1, sizeof(header), f) != sizeof(header) || std::memcmp(header, "RIFF", 4) != 0 ||
+        std::memcmp(header + 8, "WAVE", 4) != 0 || header[34] != 16)
+    {
+        std::fprintf(stderr, "%s: expected a 16-bit WAV written by render\n", path);
+        std::fclose(f);
+        return false;
+    }
+    const unsigned channels = header[22] | (header[23] << 8);
+    int16_t frame[8];
+    while (std::fread(frame, sizeof(int16_t), channels, f) == channels)
+    {
+        out.push_back(frame[0] / 32768.0f);
+    }
+    std::fclose(f);
+    return !out.empty();
+}
+
+void fft(std::vector<std::complex<float>> &a)
+{
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const float ang = -2.0f * static_cast<float>(M_PI) / static_cast<float>(len);
+        const std::complex<float> wlen(std::cos(ang), std::sin(ang));
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<float> w(1.0f, 0.0f);
+            for (size_t k = 0; k < len / 2; ++k)
+            {
+                const std::complex<float> u = a[i + k];
+                const std::complex<float> v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+std::vector<double> averagePowerSpectrum(const std::vector<float> &x)
+{
+    std::vector<double> power(kFrameSize / 2 + 1, 0.0);
+    std::vector<std::complex<float>> buf(kFrameSize);
+    size_t frames = 0;
+    for (size_t start = 0; start + kFrameSize <= x.size(); start += kFrameSize / 2)
+    {
+        for (size_t i = 0; i < kFrameSize; ++i)
+        {
+            const float w = 0.5f - 0.5f * std::cos(2.0f * static_cast<float>(M_PI) * i / (kFrameSize - 1));
+            buf[i] = x[start + i] * w;
+        }
+        fft(buf);
+        for (size_t k = 0; k < power.size(); ++k)
+        {
+            power[k] += std::norm(buf[k]);
+        }
+        ++frames;
+    }
+    for (double &p : power)
+    {
+        p /= frames ? frames : 1;
+    }
+    return power;
+}
+
+double toDb(double power)
+{
+    return 10.0 * std::log10(power + 1e-30);
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s REFERENCE.wav CANDIDATE.wav [tolerance_db]\n", argv[0]);
+        return 2;
+    }
+    const double tolerance = argc > 3 ? std::atof(argv[3]) : 0.5;
+
+    std::vector<float> ref, cand;
+    if (!readWavLeft(argv[1], ref) || !readWavLeft(argv[2], cand))
+    {
+        return 2;
+    }
+    const size_t n = std::min(ref.size(), cand.size());
+    ref.resize(n);
+    cand.resize(n);
+
+    // Time-domain difference, relative to the reference level
+    double refEnergy = 0.0, diffEnergy = 0.0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        refEnergy += static_cast<double>(ref[i]) * ref[i];
+        const double d = static_cast<double>(ref[i]) - cand[i];
+        diffEnergy += d * d;
+    }
+
+    const std::vector<double> pr = averagePowerSpectrum(ref);
+    const std::vector<double> pc = averagePowerSpectrum(cand);
+    const double peakRef = toDb(*std::max_element(pr.begin(), pr.end()));
+
+    std::printf("%10s %10s %10s %8s\n", "band Hz", "ref dB", "cand dB", "diff");
+    double worst = 0.0;
+    const double binHz = kSampleRate / kFrameSize;
+    for (double lo = 25.0; lo < kSampleRate / 2; lo *= std::pow(2.0, 1.0 / 3.0))
+    {
+        const double hi = lo * std::pow(2.0, 1.0 / 3.0);
+        double er = 0.0, ec = 0.0;
+        for (size_t k = static_cast<size_t>(lo / binHz); k < pr.size() && k * binHz < hi; ++k)
+        {
+            er += pr[k];
+            ec += pc[k];
+        }
+        const double dbr = toDb(er) - peakRef;
+        const double dbc = toDb(ec) - peakRef;
+        if (dbr < kFloorDb || er == 0.0)
+        {
+            continue;
+        }
+        const double diff = dbc - dbr;
+        worst = std::max(worst, std::fabs(diff));
+        std::printf("%10.0f %10.2f %10.2f %+8.2f\n", lo, dbr, dbc, diff);
+    }
+
+    std::printf("\nsamples: %zu, difference %.1f dB below reference, worst band %.2f dB (tolerance %.2f dB)\n", n,
+                toDb(refEnergy) - toDb(diffEnergy), worst, tolerance);
+    return worst <= tolerance ? 0 : 1;
+}
@@ -0,0 +1,538 @@
+// Offline, faster-than-real-time renderer for the PicoMudrasSequencer engine.
+//
+// Builds the four Sequencers, the VoiceManager with its VoicePresets voices and
+// the global del1/delLowPass delay exactly as PicoMudrasSequencer.ino wires them
+// in initOscillators()/fill_audio_buffer(), then drives the steps from a
+// simulated 480 PPQN clock instead of uClock. The result is written as a
+// 16-bit stereo WAV (or raw PCM) and the real-time factor is reported so the
+// headroom of the 48 kHz engine can be measured on a Linux box.
+//
+// See tools/host/README.md for build and usage notes.
+
+#include "../../src/voice/VoiceManager.h"
+#include "../../src/sequencer/Sequencer.h"
+#include "../../src/sequencer/SampleClock.h"
+#include "../../src/sequencer/ShuffleTemplates.h"
+#include "../../src/dsp/dsp.h"
+#include "../../src/dsp/svf.h"
+#include "../../src/dsp/delayline16.h"
+#include "../../src/scales/scales.h"
+#include "../../src/utils/AudioProfiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// =======================
+//   ENGINE GLOBALS (mirrors PicoMudrasSequencer.ino)
+// =======================
+constexpr float SAMPLE_RATE = 48000.0f;
+constexpr size_t MAX_DELAY_SAMPLES = static_cast<size_t>(SAMPLE_RATE * 1.8f);
+
+static Sequencer seq1(1);
+static Sequencer seq2(2);
+static Sequencer seq3(3);
+static Sequencer seq4(4);
+
+static std::unique_ptr<VoiceManager> voiceManager;
+static uint8_t voiceIds[4] = {0, 0, 0, 0};
+
+static daisysp::Svf delLowPass;
+static daisysp::DelayLine16<MAX_DELAY_SAMPLES> del1;
+static float currentDelayOutputGain = 0.0f;
+static float currentFeedbackGain = 0.0f;
+static float delayTarget = 48000.0f * .15f;
+static float currentDelay = 48000.0f * .15f;
+static float feedbackAmmount = 0.45f;
+static const float FEEDBACK_FADE_RATE = 0.001f;
+static bool delayOn = true;
+static bool perSampleVoices = false; // -S: VOICE_BLOCK_PROCESSING 0 path
+static bool bufferedEvents = false;  // -J: steps take effect at the next buffer
+static bool audioClock = false;      // -A: SampleClock instead of the uClock model
+
+static VoiceState voiceStates[4];
+
+static constexpr float INT16_MAX_AS_FLOAT = 32767.0f;
+static constexpr float INT16_MIN_AS_FLOAT = -32768.0f;
+static constexpr uint16_t TICKS_PER_STEP = PULSES_PER_SEQUENCER_STEP;
+
+// =======================
+//   OPTIONS
+// =======================
+struct RenderOptions
+{
+    const char *outPath = "render.wav";
+    bool raw = false;
+    float seconds = 30.0f;
+    float bpm = 90.0f;
+    uint32_t seed = 1;
+    int shuffle = -1; // -1 = off (uClock shuffle disabled)
+    int bufferSize = 256;
+    int controlBlockSize = -1; // -1 = keep each preset's VoiceConfig value
+    uint8_t presets[4] = {3, 2, 1, 5}; // UIState voiceNPresetIndex defaults
+};
+
+static void printUsage(const char *argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  -o PATH         output file (.wav, .raw, or - for raw PCM on stdout)\n"
+                 "  -s SECONDS      length of the render (default 30)\n"
+                 "  -t BPM          tempo (default 90)\n"
+                 "  -r SEED         pattern seed (default 1)\n"
+                 "  -p A,B,C,D      VoicePresets indices for voices 1-4 (default 3,2,1,5)\n"
+                 "  -x INDEX        shuffle template index (default off)\n"
+                 "  -n SAMPLES      samples per buffer (default 256)\n"
+                 "  -c SCALE        scale index (default 0)\n"
+                 "  -k SAMPLES      override VoiceConfig::controlBlockSize for all voices\n"
+                 "  -d              disable the global delay\n"
+                 "  -S              render voices per sample (VOICE_BLOCK_PROCESSING 0)\n"
+                 "  -J              apply steps at the start of the next buffer instead of\n"
+                 "                  on their exact sample (timing before sample-accurate events)\n"
+                 "  -A              clock the sequencer from the audio sample counter\n"
+                 "                  (SampleClock, SEQUENCER_SAMPLE_CLOCK 1) instead of uClock\n",
+                 argv0);
+}
+
+static bool parseOptions(int argc, char **argv, RenderOptions &opt)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(a, "-d") == 0)
+        {
+            delayOn = false;
+            continue;
+        }
+        if (std::strcmp(a, "-S") == 0)
+        {
+            perSampleVoices = true;
+            continue;
+        }
+        if (std::strcmp(a, "-J") == 0)
+        {
+            bufferedEvents = true;
+            continue;
+        }
+        if (std::strcmp(a, "-A") == 0)
+        {
+            audioClock = true;
+            continue;
+        }
+        if (a[0] != '-' || a[1] == '\0' || a[2] != '\0' || !v)
+        {
+            return false;
+        }
+        ++i;
+        switch (a[1])
+        {
+        case 'o': opt.outPath = v; break;
+        case 's': opt.seconds = std::strtof(v, nullptr); break;
+        case 't': opt.bpm = std::strtof(v, nullptr); break;
+        case 'r': opt.seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 10)); break;
+        case 'x': opt.shuffle = std::atoi(v); break;
+        case 'n': opt.bufferSize = std::atoi(v); break;
+        case 'k': opt.controlBlockSize = std::atoi(v); break;
+        case 'c': currentScale = static_cast<uint8_t>(std::atoi(v) % SCALES_COUNT); break;
+        case 'p':
+        {
+            unsigned p[4];
+            if (std::sscanf(v, "%u,%u,%u,%u", &p[0], &p[1], &p[2], &p[3]) != 4)
+                return false;
+            for (int k = 0; k < 4; ++k)
+                opt.presets[k] = static_cast<uint8_t>(p[k] % VoicePresets::getPresetCount());
+            break;
+        }
+        default: return false;
+        }
+    }
+    const size_t len = std::strlen(opt.outPath);
+    opt.raw = std::strcmp(opt.outPath, "-") == 0 ||
+              (len > 4 && std::strcmp(opt.outPath + len - 4, ".raw") == 0);
+    return opt.seconds > 0.0f && opt.bpm > 0.0f && opt.bufferSize > 0 &&
+           (opt.shuffle < NUM_SHUFFLE_TEMPLATES);
+}
+
+// =======================
+//   PATTERNS
+// =======================
+
+// Deterministic stand-in for ParameterManager::randomizeParameters(), which
+// seeds from the system clock. Same distributions, seeded per sequencer.
+static void programPattern(Sequencer &seq, uint32_t seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    seq.setParameterStepCount(ParamId::Slide, 16);
+    for (uint8_t step = 0; step < 16; ++step)
+    {
+        const bool gate = (step % 2 == 0) ? (unit(gen) < 0.75f) : (unit(gen) < 0.33f);
+        seq.setStepParameterValue(ParamId::Gate, step, gate ? 1.0f : 0.0f);
+        seq.setStepParameterValue(ParamId::Note, step, std::floor(unit(gen) * 21.0f));
+        seq.setStepParameterValue(ParamId::Velocity, step, unit(gen));
+        seq.setStepParameterValue(ParamId::Filter, step, 0.2f + 0.5f * unit(gen));
+        seq.setStepParameterValue(ParamId::Attack, step, 0.001f);
+        seq.setStepParameterValue(ParamId::Decay, step, 0.12f);
+        seq.setStepParameterValue(ParamId::Octave, step, 0.0f);
+        seq.setStepParameterValue(ParamId::GateLength, step, 0.1f + 0.2f * unit(gen));
+        seq.setStepParameterValue(ParamId::Slide, step, (unit(gen) < (1.0f / 13.0f)) ? 1.0f : 0.0f);
+    }
+}
+
+// =======================
+//   ENGINE (mirrors PicoMudrasSequencer.ino)
+// =======================
+static void initEngine(const RenderOptions &opt)
+{
+    delLowPass.Init(SAMPLE_RATE);
+    delLowPass.SetFreq(1340.f);
+    delLowPass.SetRes(0.19f);
+    delLowPass.SetDrive(.9f);
+
+    del1.Init();
+    del1.Reset();
+    const float delayMs1 = 500.f;
+    size_t delaySamples1 = (size_t)(delayMs1 * SAMPLE_RATE * 0.001f);
+    del1.SetDelay(delaySamples1);
+    delayTarget = static_cast<float>(delaySamples1);
+
+    voiceManager = std::make_unique<VoiceManager>(8);
+    Sequencer *seqs[4] = {&seq1, &seq2, &seq3, &seq4};
+    for (int v = 0; v < 4; ++v)
+    {
+        VoiceConfig config = VoicePresets::getPresetConfig(opt.presets[v]);
+        if (opt.controlBlockSize >= 0)
+        {
+            config.controlBlockSize = static_cast<uint8_t>(opt.controlBlockSize);
+        }
+        voiceIds[v] = voiceManager->addVoice(config);
+        voiceManager->attachSequencer(voiceIds[v], seqs[v]);
+        programPattern(*seqs[v], opt.seed * 4u + static_cast<uint32_t>(v));
+        seqs[v]->start();
+    }
+
+    // onClockStart() -> unmuteOscillators()
+    voiceManager->setVoiceVolume(voiceIds[0], 0.5f);
+    voiceManager->setVoiceVolume(voiceIds[1], 0.5f);
+}
+
+static float delayTimeSmoothing(float current, float target, float slewRate)
+{
+    float difference = target - current;
+    return current + (difference * slewRate);
+}
+
+static inline int16_t convertSampleToInt16(float sample)
+{
+    float scaled = sample * INT16_MAX_AS_FLOAT;
+    scaled = roundf(scaled);
+    scaled = daisysp::fclamp(scaled, INT16_MIN_AS_FLOAT, INT16_MAX_AS_FLOAT);
+    return static_cast<int16_t>(scaled);
+}
+
+static float processDelayEffect(float inputSignal)
+{
+    float delout = del1.Read();
+    float feedbackSignal = delout * currentFeedbackGain;
+    float filteredFeedback = delLowPass.Process<daisysp::Svf::Output::Low>(feedbackSignal);
+    del1.Write(inputSignal + (filteredFeedback * .75f));
+    return inputSignal + (delout * currentDelayOutputGain);
+}
+
+// onStepCallback() without MIDI, gate timers, distance sensor or AS5600 input.
+// Voices 1/2 keep updateVoiceParameters()' policy of only retuning on gated
+// steps; voices 3/4 follow updateVoiceParametersForVoice() and always retune.
+// Every voice command is stamped with the step's sample time.
+static void onStepCallback(uint32_t uClockCurrentStep, uint32_t atSample)
+{
+    static const UIState uiState;
+    Sequencer *seqs[4] = {&seq1, &seq2, &seq3, &seq4};
+
+    for (int v = 0; v < 4; ++v)
+    {
+        VoiceState tempState;
+        seqs[v]->advanceStep(uClockCurrentStep, -1, uiState, &tempState);
+
+        if (v >= 2 || tempState.gate)
+        {
+            int noteIndex = std::max(0, std::min(static_cast<int>(tempState.note), static_cast<int>(SCALE_STEPS - 1)));
+            float baseFreq = daisysp::mtof(scale[currentScale][noteIndex] + 36 + tempState.octave);
+            voiceManager->setVoiceFrequency(voiceIds[v], baseFreq, atSample);
+            voiceManager->setVoiceSlide(voiceIds[v], tempState.slide, atSample);
+        }
+        voiceManager->updateVoiceState(voiceIds[v], tempState, atSample);
+
+        voiceStates[v] = tempState;
+    }
+}
+
+// loop1() PPQN tick handling (note duration tracking for voices 1/2).
+static void onOutputPPQNTick()
+{
+    seq1.tickNoteDuration(&voiceStates[0]);
+    seq2.tickNoteDuration(&voiceStates[1]);
+}
+
+static void onSampleClockTick(uint32_t, uint32_t)
+{
+    onOutputPPQNTick();
+}
+
+static void fill_audio_buffer(int16_t *out, int N)
+{
+    PROF_BUFFER_BEGIN();
+    float targetDelayOutputGain = delayOn ? 1.0f : 0.0f;
+    float targetFeedbackGain = delayOn ? feedbackAmmount : 0.0f;
+
+    currentFeedbackGain = delayTimeSmoothing(currentFeedbackGain, targetFeedbackGain, FEEDBACK_FADE_RATE);
+    currentDelayOutputGain = delayTimeSmoothing(currentDelayOutputGain, targetDelayOutputGain, FEEDBACK_FADE_RATE);
+    currentDelay = delayTimeSmoothing(currentDelay, delayTarget, 0.0001f);
+
+    del1.SetDelay(currentDelay);
+
+    if (perSampleVoices)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            float finalvoice = voiceManager->processAllVoices();
+            PROF_SHARED();
+            PROF_START(profT);
+            float output = processDelayEffect(finalvoice);
+            PROF_LAP(Delay, profT);
+            float softLimitedOutput = daisysp::SoftLimit(output);
+            out[2 * i + 0] = convertSampleToInt16(softLimitedOutput * 0.5f);
+            out[2 * i + 1] = convertSampleToInt16(softLimitedOutput * 0.5f);
+        }
+        PROF_BUFFER_END();
+        return;
+    }
+
+    float voiceBlock[Voice::MAX_BLOCK_SIZE];
+    for (int blockStart = 0; blockStart < N; blockStart += Voice::MAX_BLOCK_SIZE)
+    {
+        const int blockSize = std::min(N - blockStart, static_cast<int>(Voice::MAX_BLOCK_SIZE));
+        voiceManager->processAllVoicesBlock(voiceBlock, blockSize);
+
+        PROF_SHARED();
+        PROF_START(profT);
+        for (int j = 0; j < blockSize; ++j)
+        {
+            const int i = blockStart + j;
+            float output = processDelayEffect(voiceBlock[j]);
+            float softLimitedOutput = daisysp::SoftLimit(output);
+            out[2 * i + 0] = convertSampleToInt16(softLimitedOutput * 0.5f);
+            out[2 * i + 1] = convertSampleToInt16(softLimitedOutput * 0.5f);
+        }
+        PROF_LAP(Delay, profT);
+    }
+    PROF_BUFFER_END();
+}
+
+// =======================
+//   SIMULATED 480 PPQN CLOCK
+// =======================
+
+// Replaces uClock: ticks are placed on the sample timeline and every
+// PULSES_PER_SEQUENCER_STEP ticks a step fires, offset by the selected
+// shuffle template like uClock's setShuffleTemplate(). Ticks are delivered
+// between buffers, matching core1 updating voice state while core0 renders,
+// and steps are stamped with the (rounded) sample their tick falls on.
+class SimulatedClock
+{
+  public:
+    SimulatedClock(float bpm, int shuffleTemplate)
+        : samplesPerTick_(SAMPLE_RATE * 60.0 / (static_cast<double>(bpm) * PULSES_PER_QUARTER_NOTE)),
+          shuffle_(shuffleTemplate)
+    {
+    }
+
+    void advanceTo(uint64_t samplePos)
+    {
+        while (static_cast<double>(tick_) * samplesPerTick_ <= static_cast<double>(samplePos))
+        {
+            onOutputPPQNTick();
+            while (tick_ == nextStepTick())
+            {
+                onStepCallback(step_, static_cast<uint32_t>(std::llround(static_cast<double>(tick_) * samplesPerTick_)));
+                ++step_;
+            }
+            ++tick_;
+        }
+    }
+
+    uint32_t steps() const { return step_; }
+
+  private:
+    int64_t nextStepTick() const
+    {
+        int64_t t = static_cast<int64_t>(step_) * TICKS_PER_STEP;
+        if (shuffle_ >= 0)
+        {
+            t += shuffleTemplates[shuffle_].ticks[step_ % SHUFFLE_TEMPLATE_SIZE];
+        }
+        return t < 0 ? 0 : t;
+    }
+
+    double samplesPerTick_;
+    int shuffle_;
+    int64_t tick_ = 0;
+    uint32_t step_ = 0;
+};
+
+// =======================
+//   OUTPUT
+// =======================
+static void writeLE16(FILE *f, uint16_t v)
+{
+    const uint8_t b[2] = {static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8)};
+    std::fwrite(b, 1, 2, f);
+}
+
+static void writeLE32(FILE *f, uint32_t v)
+{
+    const uint8_t b[4] = {static_cast<uint8_t>(v), static_cast<uint8_t>(v >> 8),
+                          static_cast<uint8_t>(v >> 16), static_cast<uint8_t>(v >> 24)};
+    std::fwrite(b, 1, 4, f);
+}
+
+static bool writeOutput(const RenderOptions &opt, const std::vector<int16_t> &pcm)
+{
+    FILE *f = std::strcmp(opt.outPath, "-") == 0 ? stdout : std::fopen(opt.outPath, "wb");
+    if (!f)
+    {
+        std::perror(opt.outPath);
+        return false;
+    }
+    const uint32_t dataBytes = static_cast<uint32_t>(pcm.size() * sizeof(int16_t));
+    if (!opt.raw)
+    {
+        std::fwrite("RIFF", 1, 4, f);
+        writeLE32(f, 36u + dataBytes);
+        std::fwrite("WAVEfmt ", 1, 8, f);
+        writeLE32(f, 16);                                       // fmt chunk size
+        writeLE16(f, 1);                                        // PCM
+        writeLE16(f, 2);                                        // channels
+        writeLE32(f, static_cast<uint32_t>(SAMPLE_RATE));       // sample rate
+        writeLE32(f, static_cast<uint32_t>(SAMPLE_RATE) * 4u);  // byte rate
+        writeLE16(f, 4);                                        // block align
+        writeLE16(f, 16);                                       // bits per sample
+        std::fwrite("data", 1, 4, f);
+        writeLE32(f, dataBytes);
+    }
+    for (int16_t s : pcm)
+    {
+        writeLE16(f, static_cast<uint16_t>(s));
+    }
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+static double cpuSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    RenderOptions opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    initEngine(opt);
+    AudioProfiler::begin(opt.bufferSize, SAMPLE_RATE);
+    SimulatedClock clock(opt.bpm, opt.shuffle);
+    SampleClock sampleClock;
+    if (audioClock)
+    {
+        sampleClock.init(SAMPLE_RATE);
+        sampleClock.setTempo(opt.bpm);
+        if (opt.shuffle >= 0)
+        {
+            sampleClock.setShuffleTemplate(shuffleTemplates[opt.shuffle].ticks, SHUFFLE_TEMPLATE_SIZE);
+            sampleClock.setShuffle(true);
+        }
+        sampleClock.setOnTick(onSampleClockTick);
+        sampleClock.setOnStep(onStepCallback);
+        sampleClock.start(0);
+    }
+
+    const uint64_t totalFrames = static_cast<uint64_t>(opt.seconds * SAMPLE_RATE);
+    const uint64_t bufferCount = (totalFrames + opt.bufferSize - 1) / opt.bufferSize;
+    std::vector<int16_t> pcm(bufferCount * opt.bufferSize * 2);
+
+    const double deadlineUs = 1e6 * opt.bufferSize / SAMPLE_RATE;
+    double worstBufferUs = 0.0;
+    uint64_t awakeVoiceBuffers = 0; // sum of awake voices after each buffer
+
+    const double cpuStart = cpuSeconds();
+    for (uint64_t b = 0; b < bufferCount; ++b)
+    {
+#if SEQUENCER_UNROLLED_CYCLE
+        seq1.updateUnrolledCycle();
+        seq2.updateUnrolledCycle();
+        seq3.updateUnrolledCycle();
+        seq4.updateUnrolledCycle();
+#endif
+
+        // Look one buffer ahead so every step is queued before its sample is
+        // rendered; -J only delivers ticks that already passed, which then
+        // take effect at the start of this buffer
+        if (audioClock)
+        {
+            sampleClock.advanceTo(static_cast<uint32_t>(bufferedEvents ? b * opt.bufferSize + 1 : (b + 1) * opt.bufferSize));
+        }
+        else
+        {
+            clock.advanceTo(bufferedEvents ? b * opt.bufferSize : (b + 1) * opt.bufferSize - 1);
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        fill_audio_buffer(&pcm[b * opt.bufferSize * 2], opt.bufferSize);
+        const auto t1 = std::chrono::steady_clock::now();
+
+        const double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        worstBufferUs = std::max(worstBufferUs, us);
+        awakeVoiceBuffers += voiceManager->getAwakeVoiceCount();
+    }
+    const double cpuElapsed = cpuSeconds() - cpuStart;
+
+    pcm.resize(totalFrames * 2);
+    if (!writeOutput(opt, pcm))
+    {
+        return 1;
+    }
+
+    const double audioSeconds = static_cast<double>(totalFrames) / SAMPLE_RATE;
+    const double avgBufferUs = 1e6 * cpuElapsed / static_cast<double>(bufferCount);
+    const VoiceManager::EventTimingStats &timing = voiceManager->getEventTimingStats();
+    std::fprintf(stderr,
+                 "rendered %.2f s (%u steps, %llu x %d-sample buffers) in %.3f s CPU\n"
+                 "real-time factor: %.1fx (%.2f%% of one core at %.0f Hz)\n"
+                 "buffer: avg %.1f us, worst %.1f us, deadline %.1f us\n"
+                 "voices: %.2f of %u awake on average\n"
+                 "events: %u applied, %u late, delay avg %.1f max %u samples\n",
+                 audioSeconds, audioClock ? sampleClock.getStep() : clock.steps(), static_cast<unsigned long long>(bufferCount), opt.bufferSize,
+                 cpuElapsed, audioSeconds / cpuElapsed, 100.0 * cpuElapsed / audioSeconds,
+                 static_cast<double>(SAMPLE_RATE), avgBufferUs, worstBufferUs, deadlineUs,
+                 static_cast<double>(awakeVoiceBuffers) / static_cast<double>(bufferCount),
+                 static_cast<unsigned>(voiceManager->getActiveVoiceIds().size()), timing.events, timing.late,
+                 timing.events ? static_cast<double>(timing.totalDelay) / timing.events : 0.0, timing.maxDelay);
+    AudioProfiler::printReport();
+    return 0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+// Minimal Arduino core stand-in for building the synth/sequencer sources on a
+// plain Linux host (see tools/host/README.md). Only what the audio graph and
+// sequencer touch is provided; GPIO calls are no-ops.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define A0 26
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline int analogRead(uint8_t) { return 0; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+inline long random(long howbig) { return howbig > 0 ? std::rand() % howbig : 0; }
+inline long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+inline void randomSeed(unsigned long seed) { std::srand(static_cast<unsigned>(seed)); }
+
+class __FlashStringHelper;
+#define F(str) (reinterpret_cast<const __FlashStringHelper *>(str))
+
+class String : public std::string
+{
+  public:
+    String() = default;
+    String(const char *s) : std::string(s ? s : "") {}
+    String(const std::string &s) : std::string(s) {}
+    String(int v) : std::string(std::to_string(v)) {}
+    String(unsigned v) : std::string(std::to_string(v)) {}
+    String(float v, int decimals = 2)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.*f", decimals, static_cast<double>(v));
+        assign(buf);
+    }
+};
+
+// Serial writes to stderr so rendered audio can be piped through stdout.
+class HostSerial
+{
+  public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+    void print(const char *s) { std::fputs(s, stderr); }
+    void print(const __FlashStringHelper *s) { print(reinterpret_cast<const char *>(s)); }
+    void print(const String &s) { print(s.c_str()); }
+    void print(long v) { std::fprintf(stderr, "%ld", v); }
+    void print(int v) { print(static_cast<long>(v)); }
+    void print(unsigned v) { std::fprintf(stderr, "%u", v); }
+    void print(unsigned long v) { std::fprintf(stderr, "%lu", v); }
+    void print(double v, int decimals = 2) { std::fprintf(stderr, "%.*f", decimals, v); }
+    template <typename T>
+    void println(const T &v)
+    {
+        print(v);
+        println();
+    }
+    void println() { std::fputc('\n', stderr); }
+    template <typename... Args>
+    void printf(const char *fmt, Args... args) { std::fprintf(stderr, fmt, args...); }
+};
+
+extern HostSerial Serial;
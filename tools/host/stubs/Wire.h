@@ -0,0 +1,4 @@
+#pragma once
+
+// I2C is not used by the host build; the header only has to exist.
+#include "Arduino.h"
@@ -0,0 +1,46 @@
+#include "Arduino.h"
+#include "pico/sync.h"
+#include <chrono>
+#include <thread>
+
+HostSerial Serial;
+
+static const auto s_start = std::chrono::steady_clock::now();
+
+unsigned long millis()
+{
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now() - s_start)
+                                          .count());
+}
+
+unsigned long micros()
+{
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                          std::chrono::steady_clock::now() - s_start)
+                                          .count());
+}
+
+void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// 32 hardware spin locks on the RP2350; keep the same pool size here. Unlike
+// the SDK, claims wrap around the striped range instead of panicking so host
+// tools can construct as many Sequencers as they like.
+static spin_lock_t s_spinLocks[32];
+static unsigned s_claimedSpinLocks = 0;
+
+spin_lock_t *spin_lock_instance(unsigned lock_num)
+{
+    return &s_spinLocks[lock_num & 31u];
+}
+
+int spin_lock_claim_unused(bool)
+{
+    return static_cast<int>(16u + (s_claimedSpinLocks++ % 16u));
+}
+
+// Globals the engine sources expect the sketch (PicoMudrasSequencer.ino) to define
+uint8_t currentScale = 0;
@@ -0,0 +1,48 @@
+#pragma once
+
+// Host stand-in for the pico-sdk hardware spin locks. Lock numbers are handed
+// out from a small static pool and backed by GCC atomics.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef volatile uint32_t spin_lock_t;
+
+spin_lock_t *spin_lock_instance(unsigned lock_num);
+int spin_lock_claim_unused(bool required);
+
+inline spin_lock_t *spin_lock_init(unsigned lock_num)
+{
+    spin_lock_t *lock = spin_lock_instance(lock_num);
+    *lock = 0;
+    return lock;
+}
+
+inline uint32_t spin_lock_blocking(spin_lock_t *lock)
+{
+    while (__atomic_test_and_set(const_cast<uint32_t *>(lock), __ATOMIC_ACQUIRE))
+    {
+    }
+    return 0;
+}
+
+inline void spin_unlock(spin_lock_t *lock, uint32_t)
+{
+    __atomic_clear(const_cast<uint32_t *>(lock), __ATOMIC_RELEASE);
+}
+
+// No interrupts on the host; the mask is a no-op
+inline uint32_t save_and_disable_interrupts()
+{
+    return 0;
+}
+
+inline void restore_interrupts(uint32_t)
+{
+}
+
+// The host build runs everything on one thread, which stands in for core 0
+inline unsigned get_core_num()
+{
+    return 0;
+}
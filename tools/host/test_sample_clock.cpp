@@ -0,0 +1,198 @@
+// Tick placement test for SampleClock (src/sequencer/SampleClock), the
+// clock the sketch uses with SEQUENCER_SAMPLE_CLOCK=1.
+//
+// Every tick the clock fires is checked against a double-precision model of
+// the exact tick instants, which carries the covered fraction of a tick
+// across tempo changes the way setTempo() documents. Three runs:
+//   boundary - advanceTo() stops exactly on a tick's sample, then the tempo
+//              changes, as a tempo edit right after the clock caught up
+//              does; the tick must fire there, not billions of samples later
+//   random   - tempo changes at random positions over a long run
+//   stop     - no ticks between stop() and resume(); the tick count carries
+//              on from the resume sample
+// Exits non-zero on the first misplaced tick.
+
+#include "../../src/sequencer/SampleClock.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr float kSampleRate = 48000.0f;
+
+struct Fired
+{
+    uint32_t tick;
+    uint32_t atSample;
+};
+std::vector<Fired> fired;
+
+void onTick(uint32_t tick, uint32_t atSample)
+{
+    fired.push_back(Fired{tick, atSample});
+}
+
+// Exact tick instants for a tempo sequence, in samples
+class Model
+{
+  public:
+    void start(double at, float bpm)
+    {
+        next_ = at;
+        setTempo(at, bpm);
+    }
+
+    void setTempo(double position, float bpm)
+    {
+        const double length = kSampleRate * 60.0 / (std::lround(bpm * 1000.0f) / 1000.0 * PULSES_PER_QUARTER_NOTE);
+        if (length_ > 0.0)
+        {
+            const double left = std::max(0.0, next_ - position) / length_;
+            next_ = position + left * length;
+        }
+        length_ = length;
+    }
+
+    // Sample the next tick fires on: the first at or after its instant
+    double nextSample() const { return std::ceil(next_ - 1e-6); }
+    void fire() { next_ += length_; }
+
+  private:
+    double next_ = 0.0;
+    double length_ = 0.0;
+};
+
+int failures = 0;
+
+// Checks the ticks fired since the last call against the model
+void check(const char *run, Model &model, uint32_t &expectedTick)
+{
+    for (const Fired &f : fired)
+    {
+        const double expected = model.nextSample();
+        if (f.tick != expectedTick || std::fabs(static_cast<double>(f.atSample) - expected) > 1.0)
+        {
+            if (failures++ < 5)
+            {
+                std::printf("%s: tick %u on sample %u, expected tick %u on %.0f\n", run, f.tick, f.atSample,
+                            expectedTick, expected);
+            }
+        }
+        model.fire();
+        ++expectedTick;
+    }
+    fired.clear();
+}
+
+void boundaryRun()
+{
+    static const float kTempos[] = {120.0f, 133.7f, 90.0f, 174.0f, 61.3f, 300.0f, 99.9f};
+    SampleClock clock;
+    clock.init(kSampleRate);
+    clock.setTempo(kTempos[0]);
+    clock.setOnTick(onTick);
+    clock.start(0);
+    Model model;
+    model.start(0.0, kTempos[0]);
+    uint32_t expectedTick = 0;
+
+    for (int i = 1; i < 2000; ++i)
+    {
+        // Stop on the next tick's own sample without firing it
+        const uint32_t at = clock.getNextTickSample();
+        clock.advanceTo(at);
+        check("boundary", model, expectedTick);
+
+        const float bpm = kTempos[i % (sizeof(kTempos) / sizeof(kTempos[0]))];
+        clock.setTempo(bpm);
+        model.setTempo(at, bpm);
+        const uint32_t ahead = clock.getNextTickSample() - at;
+        if (ahead > kSampleRate)
+        {
+            if (failures++ < 5)
+                std::printf("boundary: next tick %u samples ahead after setTempo(%.1f)\n", ahead,
+                            static_cast<double>(bpm));
+            return;
+        }
+        clock.advanceTo(at + 1 + (i % 37));
+        check("boundary", model, expectedTick);
+    }
+}
+
+void randomRun()
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> tempo(40.0f, 320.0f);
+    std::uniform_int_distribution<uint32_t> step(1, 3000);
+
+    SampleClock clock;
+    clock.init(kSampleRate);
+    clock.setTempo(120.0f);
+    clock.setOnTick(onTick);
+    // Start near the 32-bit wrap so the run crosses it
+    const uint32_t origin = 0xFFF00000u;
+    clock.start(origin);
+    Model model;
+    model.start(0.0, 120.0f);
+    uint32_t expectedTick = 0;
+
+    uint32_t position = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        position += step(rng);
+        clock.advanceTo(origin + position);
+        for (Fired &f : fired)
+            f.atSample -= origin;
+        check("random", model, expectedTick);
+        if (i % 3 == 0)
+        {
+            const float bpm = tempo(rng);
+            clock.setTempo(bpm);
+            model.setTempo(position, bpm);
+        }
+    }
+}
+
+void stopRun()
+{
+    SampleClock clock;
+    clock.init(kSampleRate);
+    clock.setTempo(140.0f);
+    clock.setOnTick(onTick);
+    clock.start(0);
+    clock.advanceTo(10000);
+    const uint32_t ticks = static_cast<uint32_t>(fired.size());
+    fired.clear();
+
+    clock.stop();
+    clock.advanceTo(50000);
+    if (!fired.empty() && failures++ < 5)
+        std::printf("stop: %zu ticks fired while stopped\n", fired.size());
+    fired.clear();
+
+    clock.resume(60000);
+    clock.advanceTo(61000);
+    if ((fired.empty() || fired.front().tick != ticks || fired.front().atSample != 60000) && failures++ < 5)
+        std::printf("stop: first tick after resume is %u on %u, expected %u on 60000\n",
+                    fired.empty() ? 0 : fired.front().tick, fired.empty() ? 0 : fired.front().atSample, ticks);
+    fired.clear();
+}
+} // namespace
+
+int main()
+{
+    boundaryRun();
+    randomRun();
+    stopRun();
+    if (failures > 0)
+    {
+        std::printf("FAILED: %d misplaced ticks\n", failures);
+        return 1;
+    }
+    std::printf("ok: boundary, random and stop/resume runs place every tick on its sample\n");
+    return 0;
+}